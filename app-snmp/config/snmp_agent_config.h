@@ -67,4 +67,15 @@
 /** SNMP community string for sending traps */
 #define MYSNMPAGENT_COMMUNITY_TRAP          "public"
 
+/** Zero-copy receive of SNMP request
+ *
+ * If enabled, SNMP request is received into transport's dedicated receive
+ * buffer and then passed to SNMP core as PBUF_REF pbuf referencing it, rather
+ * than copied once more to PBUF_RAM pbuf allocated from lwIP heap. Only pbuf
+ * header is taken from lwIP memp pool.
+ *
+ * @note Default to enabled. Set to 0 for the old receive path.
+ */
+#define MYSNMPAGENT_RECV_ZEROCOPY           1
+
 #endif /* ifndef DEMO_CONFIG_H */
@@ -30,9 +30,14 @@
 #include "lwip/apps/snmp_mib2.h"
 #include "snmp_agent_config.h"
 
-/* lwIP default MIB-2 + private gpio peripheral MIB */
+/* lwIP default MIB-2 + private gpio peripheral MIB + private agent MIB */
 extern "C" const struct snmp_mib gpio_perif_mib;
+#if SNMP_VALUE_CACHE_SIZE > 0 || SNMP_PROFILE
+extern "C" const struct snmp_mib agent_mib;
+static const struct snmp_mib *mysnmpagent_mibs[] = {&mib2, &gpio_perif_mib, &agent_mib};
+#else
 static const struct snmp_mib *mysnmpagent_mibs[] = {&mib2, &gpio_perif_mib};
+#endif
 
 /* SNMP device enterprise OID */
 static const struct snmp_obj_id mysnmpagent_device_enterprise_oid = {7, {1, 3, 6, 1, 4, 1, MYSNMPAGENT_VENDOR_ENTERPRISE_OID}};
@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2021, Nuvoton Technology Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+ * SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+ * OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ */
+
+#include "lwip/apps/snmp_opts.h"
+
+#if LWIP_SNMP && (SNMP_VALUE_CACHE_SIZE > 0 || SNMP_PROFILE)
+
+/* SNMP includes */
+#include "lwip/snmp.h"
+#include "lwip/apps/snmp.h"
+#include "lwip/apps/snmp_core.h"
+#include "lwip/apps/snmp_scalar.h"
+#include "lwip/apps/snmp_table.h"
+#include "snmp_agent_config.h"
+
+/* --- agent MIB .1.3.6.1.4.1.<vendor>.2 --- */
+
+/* Declare access functions */
+#if SNMP_VALUE_CACHE_SIZE > 0
+static s16_t value_cache_get_value(const struct snmp_scalar_array_node_def *node, void *value);
+#endif
+#if SNMP_PROFILE
+static snmp_err_t profile_table_get_cell_value(const u32_t *column, const u32_t *row_oid, u8_t row_oid_len, union snmp_variant_value *value, u32_t *value_len);
+static snmp_err_t profile_table_get_next_cell_instance_and_value(const u32_t *column, struct snmp_obj_id *row_oid, union snmp_variant_value *value, u32_t *value_len);
+#endif
+
+#if SNMP_VALUE_CACHE_SIZE > 0
+/* value cache .1.3.6.1.4.1.<vendor>.2.1 */
+static const struct snmp_scalar_array_node_def value_cache_nodes[] = {
+    {1, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY SNMP_NODE_CACHE_TTL(0)},  // valueCacheHits
+    {2, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY SNMP_NODE_CACHE_TTL(0)},  // valueCacheMisses
+};
+
+static const struct snmp_scalar_array_node value_cache_node =
+    SNMP_SCALAR_CREATE_ARRAY_NODE(1,
+                                  value_cache_nodes,
+                                  value_cache_get_value,
+                                  NULL,
+                                  NULL);
+#endif
+
+#if SNMP_PROFILE
+/* request phase histograms .1.3.6.1.4.1.<vendor>.2.2
+ *
+ * Indexed by profilePdu.profilePhase.profileBucket, all 1-based in the order of
+ * enum snmp_profile_pdu, enum snmp_profile_phase and the log2 buckets. Only
+ * non-empty buckets have instances.
+ */
+static const struct snmp_table_simple_col_def profile_table_columns[] = {
+    {4, SNMP_ASN1_TYPE_COUNTER, SNMP_VARIANT_VALUE_TYPE_U32 SNMP_NODE_CACHE_TTL(0)},   // profileCount
+};
+
+static const struct snmp_table_simple_node profile_table =
+    SNMP_TABLE_CREATE_SIMPLE(2,
+                             profile_table_columns,
+                             profile_table_get_cell_value,
+                             profile_table_get_next_cell_instance_and_value);
+#endif
+
+static const struct snmp_node* const agent_mib_nodes[] = {
+#if SNMP_VALUE_CACHE_SIZE > 0
+    &value_cache_node.node.node,
+#endif
+#if SNMP_PROFILE
+    &profile_table.node.node,
+#endif
+};
+
+/* --- agent MIB .1.3.6.1.4.1.<vendor>.2 --- */
+static const struct snmp_tree_node agent_mib_root = SNMP_CREATE_TREE_NODE(2, agent_mib_nodes);
+
+static const u32_t agent_mib_base_oid_arr[] = {1, 3, 6, 1, 4, 1, MYSNMPAGENT_VENDOR_ENTERPRISE_OID, 2};
+
+const struct snmp_mib agent_mib = SNMP_MIB_CREATE(agent_mib_base_oid_arr, &agent_mib_root.node);
+
+/*----------------------------------------------------------------------------*/
+
+#if SNMP_VALUE_CACHE_SIZE > 0
+
+/* value cache instance .1.3.6.1.4.1.<vendor>.2.1.<n>.0 */
+
+static s16_t value_cache_get_value(const struct snmp_scalar_array_node_def *node, void *value)
+{
+    u32_t *uint_ptr = (u32_t *) value;
+
+    switch (node->oid) {
+        case 1: /* valueCacheHits */
+            *uint_ptr = SNMP_STATS_GET(valuecachehits);
+            break;
+
+        case 2: /* valueCacheMisses */
+            *uint_ptr = SNMP_STATS_GET(valuecachemisses);
+            break;
+
+        default:
+            LWIP_DEBUGF(SNMP_MIB_DEBUG, ("value_cache_get_value(): unknown id: %"S32_F"\n", node->oid));
+            return 0;
+    }
+
+    return sizeof(*uint_ptr);
+}
+
+#endif /* SNMP_VALUE_CACHE_SIZE > 0 */
+
+#if SNMP_PROFILE
+
+/* profile table instance .1.3.6.1.4.1.<vendor>.2.2.1.4.<pdu>.<phase>.<bucket> */
+
+static snmp_err_t profile_table_get_cell_value(const u32_t *column, const u32_t *row_oid, u8_t row_oid_len, union snmp_variant_value *value, u32_t *value_len)
+{
+    LWIP_UNUSED_ARG(column);
+    LWIP_UNUSED_ARG(value_len);
+
+    if ((row_oid_len != 3) ||
+        (row_oid[0] < 1) || (row_oid[0] > SNMP_PROFILE_PDUS) ||
+        (row_oid[1] < 1) || (row_oid[1] > SNMP_PROFILE_PHASES) ||
+        (row_oid[2] < 1) || (row_oid[2] > SNMP_PROFILE_BUCKETS)) {
+        return SNMP_ERR_NOSUCHINSTANCE;
+    }
+
+    value->u32 = snmp_profile[row_oid[0] - 1][row_oid[1] - 1][row_oid[2] - 1];
+    if (value->u32 == 0) {
+        return SNMP_ERR_NOSUCHINSTANCE;
+    }
+
+    return SNMP_ERR_NOERROR;
+}
+
+static snmp_err_t profile_table_get_next_cell_instance_and_value(const u32_t *column, struct snmp_obj_id *row_oid, union snmp_variant_value *value, u32_t *value_len)
+{
+    LWIP_UNUSED_ARG(column);
+    LWIP_UNUSED_ARG(value_len);
+
+    /* Rows are enumerated in OID order, so the first non-empty one after row_oid is the next */
+    for (u32_t pdu = 1; pdu <= SNMP_PROFILE_PDUS; pdu++) {
+        for (u32_t phase = 1; phase <= SNMP_PROFILE_PHASES; phase++) {
+            for (u32_t bucket = 1; bucket <= SNMP_PROFILE_BUCKETS; bucket++) {
+                const u32_t test_oid[] = {pdu, phase, bucket};
+                u32_t count;
+
+                if (snmp_oid_compare(test_oid, LWIP_ARRAYSIZE(test_oid), row_oid->id, row_oid->len) <= 0) {
+                    continue;
+                }
+
+                count = snmp_profile[pdu - 1][phase - 1][bucket - 1];
+                if (count != 0) {
+                    snmp_oid_assign(row_oid, test_oid, LWIP_ARRAYSIZE(test_oid));
+                    value->u32 = count;
+                    return SNMP_ERR_NOERROR;
+                }
+            }
+        }
+    }
+
+    return SNMP_ERR_NOSUCHINSTANCE;
+}
+
+#endif /* SNMP_PROFILE */
+
+#endif /* LWIP_SNMP && (SNMP_VALUE_CACHE_SIZE > 0 || SNMP_PROFILE) */
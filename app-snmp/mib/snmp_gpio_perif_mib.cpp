@@ -49,8 +49,8 @@ static snmp_err_t leds_set_value(const struct snmp_scalar_array_node_def *node,
 
 /* buttons .1.3.6.1.4.1.<vendor>.1.1 */
 static const struct snmp_scalar_array_node_def button_nodes[] = {
-    {1, SNMP_ASN1_TYPE_INTEGER, SNMP_NODE_INSTANCE_READ_ONLY},  // BUTTON1
-    {2, SNMP_ASN1_TYPE_INTEGER, SNMP_NODE_INSTANCE_READ_ONLY},  // BUTTON2
+    {1, SNMP_ASN1_TYPE_INTEGER, SNMP_NODE_INSTANCE_READ_ONLY SNMP_NODE_CACHE_TTL(0)},  // BUTTON1
+    {2, SNMP_ASN1_TYPE_INTEGER, SNMP_NODE_INSTANCE_READ_ONLY SNMP_NODE_CACHE_TTL(0)},  // BUTTON2
 };
 
 static const struct snmp_scalar_array_node buttons_node =
@@ -62,8 +62,8 @@ static const struct snmp_scalar_array_node buttons_node =
 
 /* leds .1.3.6.1.4.1.<vendor>.1.2 */
 static const struct snmp_scalar_array_node_def led_nodes[] = {
-    {1, SNMP_ASN1_TYPE_INTEGER, SNMP_NODE_INSTANCE_READ_WRITE}, // LED1
-    {2, SNMP_ASN1_TYPE_INTEGER, SNMP_NODE_INSTANCE_READ_WRITE}, // LED2
+    {1, SNMP_ASN1_TYPE_INTEGER, SNMP_NODE_INSTANCE_READ_WRITE SNMP_NODE_CACHE_TTL(0)}, // LED1
+    {2, SNMP_ASN1_TYPE_INTEGER, SNMP_NODE_INSTANCE_READ_WRITE SNMP_NODE_CACHE_TTL(0)}, // LED2
 };
 
 static const struct snmp_scalar_array_node leds_node =
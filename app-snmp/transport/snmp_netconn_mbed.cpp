@@ -34,6 +34,7 @@
 #include "lwip/ip.h"
 #include "lwip/udp.h"
 #include "snmp_msg.h"
+#include "snmp_core_priv.h"
 #include "lwip/sys.h"
 #include "lwip/prot/iana.h"
 #include "snmp_agent_config.h"
@@ -41,6 +42,9 @@
 /* Mbed includes */
 #include "mbed.h"
 #include "mbed_trace.h"
+#if SNMP_PROFILE
+#include "hal/us_ticker_api.h"
+#endif
 
 #if MBED_CONF_MBED_TRACE_ENABLE
 #define TRACE_GROUP     "lwIP"
@@ -65,6 +69,106 @@
 #endif /* LWIP_IPV6 */
 #endif
 
+/* Convert Mbed SocketAddress to lwIP ip_addr_t
+ *
+ * Convert in binary, without formatting to and parsing from string per packet.
+ */
+static bool
+sockaddr_to_ipaddr(const SocketAddress &sockaddr, ip_addr_t *ipaddr)
+{
+    nsapi_addr_t addr = sockaddr.get_addr();
+
+    switch (addr.version) {
+#if LWIP_IPV4
+        case NSAPI_IPv4:
+            IP_ADDR4(ipaddr, addr.bytes[0], addr.bytes[1], addr.bytes[2], addr.bytes[3]);
+            return true;
+#endif
+
+#if LWIP_IPV6
+        case NSAPI_IPv6:
+            IP_SET_TYPE(ipaddr, IPADDR_TYPE_V6);
+            /* Both in network byte order */
+            MEMCPY(ip_2_ip6(ipaddr)->addr, addr.bytes, sizeof(ip_2_ip6(ipaddr)->addr));
+            ip6_addr_clear_zone(ip_2_ip6(ipaddr));
+            return true;
+#endif
+
+        default:
+            return false;
+    }
+}
+
+/* Convert lwIP ip_addr_t to Mbed SocketAddress
+ *
+ * Same as above, but reverse.
+ */
+static bool
+ipaddr_to_sockaddr(const ip_addr_t *ipaddr, SocketAddress &sockaddr)
+{
+    nsapi_addr_t addr = {};
+
+#if LWIP_IPV6
+    if (IP_IS_V6(ipaddr)) {
+        addr.version = NSAPI_IPv6;
+        MEMCPY(addr.bytes, ip_2_ip6(ipaddr)->addr, sizeof(ip_2_ip6(ipaddr)->addr));
+        sockaddr.set_addr(addr);
+        return true;
+    }
+#endif
+
+#if LWIP_IPV4
+    if (IP_IS_V4(ipaddr)) {
+        addr.version = NSAPI_IPv4;
+        /* Both in network byte order */
+        MEMCPY(addr.bytes, &ip_2_ip4(ipaddr)->addr, sizeof(ip_2_ip4(ipaddr)->addr));
+        sockaddr.set_addr(addr);
+        return true;
+    }
+#endif
+
+    return false;
+}
+
+/* Local IP address cache entries, one per IP version of the network interface */
+enum SNMPLocalIPIndex
+{
+    SNMP_LOCAL_IP_V4 = 0,
+    SNMP_LOCAL_IP_V6,
+    /* Source for IPv6 link-local destinations */
+    SNMP_LOCAL_IP_V6_LINK_LOCAL,
+    SNMP_LOCAL_IP_NUM
+};
+
+enum SNMPLocalIPState
+{
+    /* Not looked up since last network status change */
+    SNMP_LOCAL_IP_UNKNOWN = 0,
+    SNMP_LOCAL_IP_FOUND,
+    /* Interface has no address of this IP version */
+    SNMP_LOCAL_IP_NONE
+};
+
+struct SNMPLocalIP
+{
+    SNMPLocalIPState    state;
+    ip_addr_t           ipaddr;
+};
+
+/* SNMP request received, passed from receiver thread to worker threads or
+ * kept until the whole receive batch is taken */
+struct SNMPRequestMessage
+{
+    SocketAddress   sockaddr;
+    nsapi_size_t    udp_payload_size;
+    uint8_t         udp_payload[UDP_PAYLOAD_MAXSIZE];
+};
+
+#if SNMP_WORKER_THREADS > 1
+/* SNMP request messages in flight: one in process and one queued for each worker */
+#define SNMP_DISPATCH_QUEUE_SIZE        (SNMP_WORKER_THREADS * 2)
+#endif
+
 /* SNMP transport context */
 struct SNMPTransportContext
 {
@@ -80,11 +184,169 @@ struct SNMPTransportContext
     /* Send SNMP trap */
     UDPSocket   udpsock_trap;
     uint8_t     udp_payload_buf[UDP_PAYLOAD_MAXSIZE];
+#if (SNMP_WORKER_THREADS == 1) && (MYSNMPAGENT_RECV_ZEROCOPY || (SNMP_RECV_BATCH_SIZE > 1))
+    /* Receive buffers, one per request of the receive batch
+     *
+     * Must be separate from udp_payload_buf above, which snmp_sendto() may
+     * use for flattening response/trap while SNMP request is still in process.
+     * With zero-copy, they are referenced by PBUF_REF pbuf passed to SNMP core.
+     */
+    SNMPRequestMessage  recv_batch[SNMP_RECV_BATCH_SIZE];
+#endif
+#if SNMP_WORKER_THREADS > 1
+    /* Dispatch SNMP requests from receiver thread to worker threads
+     *
+     * Every request message carries its own receive buffer, so one worker's
+     * request is not overwritten by next receive.
+     */
+    Mail<SNMPRequestMessage, SNMP_DISPATCH_QUEUE_SIZE>  dispatch_queue;
+#endif
+    /* Serialize snmp_sendto() among workers and trap sender thread
+     *
+     * This guards udp_payload_buf and ipaddr_trap_dst_redirect, which are
+     * shared by all senders.
+     */
+    Mutex       send_mutex;
 #ifdef MYSNMPAGENT_TRAP_DST_IP
     ip_addr_t   ipaddr_trap_dst_redirect;
 #endif
+    /* Network interface which above sockets are opened on */
+    NetworkInterface *  net;
+    /* Local IP address cache for snmp_get_local_ip_for_dst()
+     *
+     * Local IP address is looked up per trap destination. To save driver call
+     * per lookup, look it up once per IP version until network status changes.
+     */
+    Mutex       local_ip_mutex;
+    /* Bumped by network status callback to invalidate the cache */
+    uint32_t    local_ip_gen;
+    /* Value of local_ip_gen when the cache was last checked */
+    uint32_t    local_ip_cache_gen;
+    SNMPLocalIP local_ip[SNMP_LOCAL_IP_NUM];
 };
 
+/* Invalidate local IP address cache on network status change
+ *
+ * This can run in interrupt context, so just bump the generation.
+ */
+static void
+snmp_netconn_status_cb(SNMPTransportContext *snmp_trans_ctx, nsapi_event_t event, intptr_t value)
+{
+    LWIP_UNUSED_ARG(value);
+
+    if (event == NSAPI_EVENT_CONNECTION_STATUS_CHANGE) {
+        core_util_atomic_incr_u32(&snmp_trans_ctx->local_ip_gen, 1);
+    }
+}
+
+/* Check SNMP request source against its rate limit
+ *
+ * This is done right after receive, so that a request over the limit costs
+ * neither a dispatch message nor BER parse.
+ */
+static bool
+snmp_netconn_admit(const SocketAddress &sockaddr)
+{
+#if SNMP_RATE_LIMIT_SOURCES > 0
+    ip_addr_t ipaddr;
+    if (sockaddr_to_ipaddr(sockaddr, &ipaddr) && !snmp_rate_limit_admit(&ipaddr)) {
+        tr_debug("Drop SNMP request over rate limit from: %s", sockaddr.get_ip_address());
+        return false;
+    }
+#else
+    LWIP_UNUSED_ARG(sockaddr);
+#endif
+
+    return true;
+}
+
+/* Pass received SNMP request to SNMP core for handling */
+static void
+snmp_netconn_dispatch(SNMPTransportContext *snmp_trans_ctx,
+                      const SocketAddress &sockaddr,
+                      uint8_t *udp_payload,
+                      nsapi_size_t udp_payload_size)
+{
+    struct pbuf *p = NULL;
+
+#if MYSNMPAGENT_RECV_ZEROCOPY
+    /* Reference received SNMP request in place
+     *
+     * No copy and no lwIP heap allocation. The receive buffer keeps valid
+     * until snmp_receive() returns and pbuf is freed below.
+     */
+    p = pbuf_alloc_reference(udp_payload, udp_payload_size, PBUF_REF);
+    if (p == NULL) {
+        tr_error("pbuf_alloc_reference() for SNMP request failed");
+        return;
+    }
+#else
+    /* pbuf's tot_len same as UDP payload size
+     *
+     * pbuf's tot_len means both maximum size and effective size. We should
+     * allocate pbuf whose size is exactly the same as (not larger than) UDP
+     * payload size, or we are required to call pbuf_realloc() to shrink it.
+     */
+    p = pbuf_alloc(PBUF_TRANSPORT, udp_payload_size, PBUF_RAM);
+    if (p == NULL) {
+        tr_error("pbuf_alloc() for SNMP request failed");
+        return;
+    }
+
+    /* Copy received SNMP request to pbuf */
+    err_t rc_lwip = pbuf_take(p, udp_payload, udp_payload_size);
+    if (rc_lwip != ERR_OK) {
+        tr_error("pbuf_take() for copying SNMP request to pbuf failed: %d", rc_lwip);
+        pbuf_free(p);
+        return;
+    }
+#endif
+
+    ip_addr_t ipaddr;
+    if (!sockaddr_to_ipaddr(sockaddr, &ipaddr)) {
+        tr_error("Unsupported SNMP request source IP address");
+        pbuf_free(p);
+        return;
+    }
+
+#ifdef MYSNMPAGENT_TRAP_DST_IP
+    /* Keep SNMP request source as trap destination when it is dummy */
+    snmp_trans_ctx->send_mutex.lock();
+    ip_addr_copy(snmp_trans_ctx->ipaddr_trap_dst_redirect, ipaddr);
+    snmp_trans_ctx->send_mutex.unlock();
+#endif
+
+    /* Pass to SNMP core for handling */
+    snmp_receive(snmp_trans_ctx, p, &ipaddr, sockaddr.get_port());
+
+    pbuf_free(p);
+}
+
+#if SNMP_WORKER_THREADS > 1
+/** SNMP worker thread, handling SNMP requests dispatched by SNMP netconn API thread */
+static void
+snmp_worker_thread(void *arg)
+{
+    SNMPTransportContext *snmp_trans_ctx = (SNMPTransportContext *) arg;
+
+    tr_info("SNMP worker thread started");
+
+    do {
+        SNMPRequestMessage *msg = snmp_trans_ctx->dispatch_queue.try_get_for(Kernel::wait_for_u32_forever);
+        if (msg == NULL) {
+            continue;
+        }
+
+        snmp_netconn_dispatch(snmp_trans_ctx,
+                              msg->sockaddr,
+                              msg->udp_payload,
+                              msg->udp_payload_size);
+
+        snmp_trans_ctx->dispatch_queue.free(msg);
+    } while (1);
+}
+#endif
+
 /** SNMP netconn API worker thread */
 static void
 snmp_netconn_thread(void *arg)
@@ -95,19 +357,25 @@ snmp_netconn_thread(void *arg)
 
     nsapi_size_or_error_t rc_nsapi = NSAPI_ERROR_OK;
     SNMPTransportContext *snmp_trans_ctx = NULL;
-    struct pbuf *p = NULL;
 
     snmp_trans_ctx = new SNMPTransportContext;
 
+    snmp_trans_ctx->net = NetworkInterface::get_default_instance();
+    snmp_trans_ctx->local_ip_gen = 0;
+    snmp_trans_ctx->local_ip_cache_gen = 0;
+    for (int i = 0; i < SNMP_LOCAL_IP_NUM; i++) {
+        snmp_trans_ctx->local_ip[i].state = SNMP_LOCAL_IP_UNKNOWN;
+    }
+
     /* Open a network socket on the network stack of the given network interface */
-    rc_nsapi = snmp_trans_ctx->udpsock.open(NetworkInterface::get_default_instance());
+    rc_nsapi = snmp_trans_ctx->udpsock.open(snmp_trans_ctx->net);
     if (rc_nsapi != NSAPI_ERROR_OK) {
         tr_err("Open UDP socket on network stack failed: %d", rc_nsapi);
         goto cleanup;
     }
 
     /* Same as above, but for sending traps */
-    rc_nsapi = snmp_trans_ctx->udpsock_trap.open(NetworkInterface::get_default_instance());
+    rc_nsapi = snmp_trans_ctx->udpsock_trap.open(snmp_trans_ctx->net);
     if (rc_nsapi != NSAPI_ERROR_OK) {
         tr_err("Open UDP socket (for sending traps) on network stack failed: %d", rc_nsapi);
         goto cleanup;
@@ -126,66 +394,115 @@ snmp_netconn_thread(void *arg)
      * SNMP response and trap. */
     snmp_traps_handle = snmp_trans_ctx;
 
+    /* Keep local IP address cache consistent with network status. Don't use
+     * attach(), which would replace application's status callback. */
+    snmp_trans_ctx->net->add_event_listener(mbed::callback(snmp_netconn_status_cb, snmp_trans_ctx));
+
+#if SNMP_WORKER_THREADS > 1
+    /* This thread just receives. SNMP requests are handled by worker threads. */
+    for (int i = 0; i < SNMP_WORKER_THREADS; i++) {
+        sys_thread_new("snmp_worker", snmp_worker_thread, snmp_trans_ctx, SNMP_STACK_SIZE, SNMP_THREAD_PRIO);
+    }
+#endif
+
     do {
-        if (p != NULL) {
-            pbuf_free(p);
-            p = NULL;
-        }
+        /* Block for the first request, then drain the socket without blocking
+         * up to SNMP_RECV_BATCH_SIZE requests, saving one wakeup per request
+         * under burst. */
+        int batch_size = 0;
+#if (SNMP_WORKER_THREADS == 1) && (MYSNMPAGENT_RECV_ZEROCOPY || (SNMP_RECV_BATCH_SIZE > 1))
+        /* Requests of the batch admitted for handling */
+        int num_admitted = 0;
+#endif
+        while (batch_size < SNMP_RECV_BATCH_SIZE) {
+#if SNMP_WORKER_THREADS > 1
+            /* Wait for free request message. This throttles receive when all
+             * workers are busy. Never wait within a batch. */
+            SNMPRequestMessage *msg = (batch_size == 0) ?
+                                      snmp_trans_ctx->dispatch_queue.try_alloc_for(Kernel::wait_for_u32_forever) :
+                                      snmp_trans_ctx->dispatch_queue.try_alloc();
+            if (msg == NULL) {
+                break;
+            }
+            SocketAddress &sockaddr = msg->sockaddr;
+            uint8_t *udp_recv_buf = msg->udp_payload;
+#elif MYSNMPAGENT_RECV_ZEROCOPY || (SNMP_RECV_BATCH_SIZE > 1)
+            SNMPRequestMessage *msg = &snmp_trans_ctx->recv_batch[num_admitted];
+            SocketAddress &sockaddr = msg->sockaddr;
+            uint8_t *udp_recv_buf = msg->udp_payload;
+#else
+            SocketAddress sockaddr;
+            uint8_t *udp_recv_buf = snmp_trans_ctx->udp_payload_buf;
+#endif
 
-        SocketAddress sockaddr;
-        rc_nsapi = snmp_trans_ctx->udpsock.recvfrom(&sockaddr,
-                                                    snmp_trans_ctx->udp_payload_buf,
-                                                    UDP_PAYLOAD_MAXSIZE);
-        if (rc_nsapi <= 0) {
-            tr_warn("Receive SNMP request over UDP failed: %d", rc_nsapi);
-            continue;
-        }
+            rc_nsapi = snmp_trans_ctx->udpsock.recvfrom(&sockaddr,
+                                                        udp_recv_buf,
+                                                        UDP_PAYLOAD_MAXSIZE);
+            if (rc_nsapi <= 0) {
+                /* Socket drained */
+                if (rc_nsapi != NSAPI_ERROR_WOULD_BLOCK) {
+                    tr_warn("Receive SNMP request over UDP failed: %d", rc_nsapi);
+                }
+#if SNMP_WORKER_THREADS > 1
+                snmp_trans_ctx->dispatch_queue.free(msg);
+#endif
+                break;
+            }
+
+            tr_info("Receive SNMP request (%d) over UDP from: %s:%d",
+                    rc_nsapi,
+                    sockaddr.get_ip_address(),
+                    sockaddr.get_port());
+
+            batch_size++;
+#if SNMP_RECV_BATCH_SIZE > 1
+            if (batch_size == 1) {
+                snmp_trans_ctx->udpsock.set_blocking(false);
+            }
+#endif
 
-        tr_info("Receive SNMP request (%d) over UDP from: %s:%d",
-                rc_nsapi,
-                sockaddr.get_ip_address(),
-                sockaddr.get_port());
-
-        /* pbuf's tot_len same as UDP payload size
-         *
-         * pbuf's tot_len means both maximum size and effective size. We should
-         * allocate pbuf whose size is exactly the same as (not larger than) UDP
-         * payload size, or we are required to call pbuf_realloc() to shrink it.
-         */
-        p = pbuf_alloc(PBUF_TRANSPORT, rc_nsapi, PBUF_RAM);
-        if (p == NULL) {
-            tr_error("pbuf_alloc() for SNMP request failed");
-            continue;
+            if (!snmp_netconn_admit(sockaddr)) {
+#if SNMP_WORKER_THREADS > 1
+                snmp_trans_ctx->dispatch_queue.free(msg);
+#endif
+                continue;
+            }
+
+#if SNMP_WORKER_THREADS > 1
+            msg->udp_payload_size = rc_nsapi;
+            snmp_trans_ctx->dispatch_queue.put(msg);
+#elif MYSNMPAGENT_RECV_ZEROCOPY || (SNMP_RECV_BATCH_SIZE > 1)
+            msg->udp_payload_size = rc_nsapi;
+            num_admitted++;
+#else
+            snmp_netconn_dispatch(snmp_trans_ctx, sockaddr, udp_recv_buf, rc_nsapi);
+#endif
         }
 
-        /* Copy received SNMP request to pbuf */
-        err_t rc_lwip = pbuf_take(p, snmp_trans_ctx->udp_payload_buf, rc_nsapi);
-        if (rc_lwip != ERR_OK) {
-            tr_error("pbuf_take() for copying SNMP request to pbuf failed: %d", rc_lwip);
+        if (batch_size == 0) {
             continue;
         }
 
-        ip_addr_t ipaddr;
-        ipaddr_aton(sockaddr.get_ip_address(), &ipaddr);
-
-#ifdef MYSNMPAGENT_TRAP_DST_IP
-        /* Keep SNMP request source as trap destination when it is dummy */
-        ip_addr_copy(snmp_trans_ctx->ipaddr_trap_dst_redirect, ipaddr);
+#if SNMP_RECV_BATCH_SIZE > 1
+        snmp_trans_ctx->udpsock.set_blocking(true);
+        SNMP_STATS_INC(inbatchsizes[batch_size - 1]);
 #endif
 
-        /* Pass to SNMP core for handling */
-        snmp_receive(snmp_trans_ctx, p, &ipaddr, sockaddr.get_port());
-
+#if (SNMP_WORKER_THREADS == 1) && (MYSNMPAGENT_RECV_ZEROCOPY || (SNMP_RECV_BATCH_SIZE > 1))
+        /* Handle the whole batch. Responses go out as each request completes. */
+        for (int i = 0; i < num_admitted; i++) {
+            SNMPRequestMessage *msg = &snmp_trans_ctx->recv_batch[i];
+            snmp_netconn_dispatch(snmp_trans_ctx,
+                                  msg->sockaddr,
+                                  msg->udp_payload,
+                                  msg->udp_payload_size);
+        }
+#endif
     } while (1);
 
     /* Clean up resource */
 cleanup:
 
-    if (p != NULL) {
-        pbuf_free(p);
-        p = NULL;
-    }
-
     delete snmp_trans_ctx;
     snmp_trans_ctx = NULL;
 }
@@ -199,6 +516,8 @@ snmp_sendto(void *handle, struct pbuf *p, const ip_addr_t *dst, u16_t port)
         return ERR_ARG;
     }
 
+    ScopedLock<Mutex> lock(snmp_trans_ctx->send_mutex);
+
     size_t udp_payload_size = p->tot_len;
     void *udp_payload = pbuf_get_contiguous(p,
                                             snmp_trans_ctx->udp_payload_buf,
@@ -214,19 +533,25 @@ snmp_sendto(void *handle, struct pbuf *p, const ip_addr_t *dst, u16_t port)
     /* For development, if destination IP is dummy, regard it as trap destination
      * IP and change to the SNMP request source. */
     ip_addr_t trap_dst_ip_dummy = TRAP_DST_IP_DUMMY;
-    if (ip_addr_cmp(dst, &trap_dst_ip_dummy)) {
+    bool trap_dst_redirect = ip_addr_cmp(dst, &trap_dst_ip_dummy);
+    if (trap_dst_redirect) {
         dst = &snmp_trans_ctx->ipaddr_trap_dst_redirect;
-        tr_warn("Trap destination IP is dummy. Change to the SNMP request source: %s", ipaddr_ntoa(dst));
     }
 #endif
 
-    SocketAddress sockaddr;    
-    if (!sockaddr.set_ip_address(ipaddr_ntoa(dst))) {
+    SocketAddress sockaddr;
+    if (!ipaddr_to_sockaddr(dst, sockaddr)) {
         tr_error("snmp_sendto(): Invalid destination IP address");
         return ERR_ARG;
     }
     sockaddr.set_port(port);
 
+#ifdef MYSNMPAGENT_TRAP_DST_IP
+    if (trap_dst_redirect) {
+        tr_warn("Trap destination IP is dummy. Change to the SNMP request source: %s", sockaddr.get_ip_address());
+    }
+#endif
+
     /* Send response or trap? */
     bool send_trap = (sockaddr.get_port() == LWIP_IANA_PORT_SNMP_TRAP);
 
@@ -256,30 +581,125 @@ snmp_sendto(void *handle, struct pbuf *p, const ip_addr_t *dst, u16_t port)
     return ERR_OK;
 }
 
+/* Look up local IP address of one IP version once per network status change
+ *
+ * Traps go out through the network interface which the trap socket is opened
+ * on, so local IP address is that interface's one of the destination's IP
+ * version: its primary address, or its IPv6 link-local address for IPv6
+ * link-local destinations. Destinations of an IP version the interface has no
+ * address of are skipped.
+ *
+ * Must be called with local_ip_mutex held. Returns false if the lookup failed,
+ * which is not cached.
+ */
+static bool
+snmp_netconn_local_ip_lookup(SNMPTransportContext *snmp_trans_ctx, SNMPLocalIPIndex index)
+{
+    uint32_t local_ip_gen = core_util_atomic_load_u32(&snmp_trans_ctx->local_ip_gen);
+    if (snmp_trans_ctx->local_ip_cache_gen != local_ip_gen) {
+        /* Network status changed since last lookup */
+        for (int i = 0; i < SNMP_LOCAL_IP_NUM; i++) {
+            snmp_trans_ctx->local_ip[i].state = SNMP_LOCAL_IP_UNKNOWN;
+        }
+        snmp_trans_ctx->local_ip_cache_gen = local_ip_gen;
+    }
+
+    SNMPLocalIP &local_ip = snmp_trans_ctx->local_ip[index];
+    if (local_ip.state != SNMP_LOCAL_IP_UNKNOWN) {
+        return true;
+    }
+
+    SocketAddress sockaddr;
+    nsapi_size_or_error_t rc_nsapi;
+    if (index == SNMP_LOCAL_IP_V6_LINK_LOCAL) {
+        rc_nsapi = snmp_trans_ctx->net->get_ipv6_link_local_address(&sockaddr);
+    } else {
+        rc_nsapi = snmp_trans_ctx->net->get_ip_address(&sockaddr);
+        if (rc_nsapi != NSAPI_ERROR_OK) {
+            tr_err("snmp_get_local_ip_for_dst: Get local IP address failed: %d", rc_nsapi);
+            return false;
+        }
+    }
+
+    /* Not an error, e.g. IPv4-only interface or IP version disabled in lwIP */
+    nsapi_version_t version = (index == SNMP_LOCAL_IP_V4) ? NSAPI_IPv4 : NSAPI_IPv6;
+    if (rc_nsapi != NSAPI_ERROR_OK ||
+        sockaddr.get_ip_version() != version ||
+        !sockaddr_to_ipaddr(sockaddr, &local_ip.ipaddr)) {
+        local_ip.state = SNMP_LOCAL_IP_NONE;
+        return true;
+    }
+    local_ip.state = SNMP_LOCAL_IP_FOUND;
+
+    return true;
+}
+
 u8_t
 snmp_get_local_ip_for_dst(void *handle, const ip_addr_t *dst, ip_addr_t *result)
 {
-    LWIP_UNUSED_ARG(handle);
+    SNMPTransportContext *snmp_trans_ctx = (SNMPTransportContext *) handle;
+    if (snmp_trans_ctx == NULL) {
+        tr_err("snmp_get_local_ip_for_dst: Invalid handle");
+        return 0;
+    }
 
-    /* Use the IP binding to the network interface */
-    LWIP_UNUSED_ARG(dst);
+    LWIP_UNUSED_ARG(dst); /* in case of IPv4 only configuration without trace */
 
-    auto net = NetworkInterface::get_default_instance();
-    if (net == NULL) {
-        tr_err("snmp_get_local_ip_for_dst: Null network interface");
-        return 0;
+    SNMPLocalIPIndex index = SNMP_LOCAL_IP_V4;
+#if LWIP_IPV6
+    if (IP_IS_V6(dst)) {
+        index = ip6_addr_islinklocal(ip_2_ip6(dst)) ? SNMP_LOCAL_IP_V6_LINK_LOCAL : SNMP_LOCAL_IP_V6;
     }
+#endif
 
-    SocketAddress sockaddr;
-    nsapi_size_or_error_t rc_nsapi = net->get_ip_address(&sockaddr);
-    if (rc_nsapi != NSAPI_ERROR_OK) {
-        tr_err("snmp_get_local_ip_for_dst: Get local IP address failed: %d", rc_nsapi);
+    ScopedLock<Mutex> lock(snmp_trans_ctx->local_ip_mutex);
+
+    if (!snmp_netconn_local_ip_lookup(snmp_trans_ctx, index)) {
         return 0;
     }
 
-    return ipaddr_aton(sockaddr.get_ip_address(), result);
+    const SNMPLocalIP &local_ip = snmp_trans_ctx->local_ip[index];
+    if (local_ip.state != SNMP_LOCAL_IP_FOUND) {
+        tr_warn("snmp_get_local_ip_for_dst: No local IP address for destination %s IP version",
+                IP_IS_V6(dst) ? "IPv6" : "IPv4");
+        return SNMP_LOCAL_IP_NO_VERSION;
+    }
+
+    ip_addr_copy(*result, local_ip.ipaddr);
+    return 1;
+}
+
+u16_t
+snmp_get_max_payload_for_dst(void *handle, const ip_addr_t *dst)
+{
+    (void) handle;
+    (void) dst;
+
+    /* Mbed OS network stacks fragment IP datagrams, so the response is only
+     * limited by the send buffer of snmp_sendto(). */
+    return UDP_PAYLOAD_MAXSIZE;
 }
 
+#if SNMP_PROFILE
+/* Profile ticks are core clock cycles from the DWT cycle counter, or
+ * microseconds from the us ticker on cores without it (e.g. Cortex-M0/M23).
+ */
+u32_t
+snmp_profile_now(void)
+{
+#if defined(DWT_CTRL_CYCCNTENA_Msk)
+    if (!(DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk)) {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+    return DWT->CYCCNT;
+#else
+    return us_ticker_read();
+#endif
+}
+#endif
+
 /**
  * Starts SNMP Agent.
  */
@@ -287,6 +707,12 @@ void
 snmp_init(void)
 {
   LWIP_ASSERT_CORE_LOCKED();
+#if SNMP_WORKER_THREADS > 1
+  snmp_msg_init();
+#endif
+#if SNMP_TRAP_QUEUE_SIZE > 0
+  snmp_trap_queue_init();
+#endif
   sys_thread_new("snmp_netconn", snmp_netconn_thread, NULL, SNMP_STACK_SIZE, SNMP_THREAD_PRIO);
 }
 
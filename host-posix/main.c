@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2021, Nuvoton Technology Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Linux host build of SNMP Agent
+ *
+ * Run the same lwip-snmp message engine and MIB-2 as on target, but over
+ * BSD UDP sockets, for profiling on a workstation with net-snmp tools over
+ * loopback, e.g.:
+ *
+ *     snmp-agent-host 1161
+ *     snmpwalk -v2c -c public 127.0.0.1:1161
+ *
+ * The private gpio peripheral MIB is target-only and not included.
+ *
+ * With SNMP_PROFILE, type "profile" on stdin to print the phase latency
+ * histograms.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/* lwIP includes */
+#include "lwip/sys.h"
+#include "lwip/tcpip.h"
+#include "lwip/netif.h"
+#include "lwip/apps/snmp.h"
+#include "lwip/apps/snmp_mib2.h"
+#include "lwip/apps/snmp_core.h"
+#include "snmp_agent_config.h"
+#include "snmp_posix.h"
+
+/* lwIP default MIB-2 + private agent MIB */
+#if SNMP_VALUE_CACHE_SIZE > 0 || SNMP_PROFILE
+extern const struct snmp_mib agent_mib;
+static const struct snmp_mib *mysnmpagent_mibs[] = {&mib2, &agent_mib};
+#else
+static const struct snmp_mib *mysnmpagent_mibs[] = {&mib2};
+#endif
+
+/* SNMP device enterprise OID */
+static const struct snmp_obj_id mysnmpagent_device_enterprise_oid = {7, {1, 3, 6, 1, 4, 1, MYSNMPAGENT_VENDOR_ENTERPRISE_OID}};
+
+#ifdef MYSNMPAGENT_TRAP_DST_IP
+/* SNMP trap destination IP */
+static const char mysnmpagent_trap_dst_ip[]     = MYSNMPAGENT_TRAP_DST_IP;
+#endif
+
+/* SNMP MIB-2 system group 1.3.6.1.2.1.1 */
+static const u8_t mysnmpagent_sysdescr[]        = MYSNMPAGENT_MIB2_SYSDESCR;
+static const u16_t mysnmpagent_sysdescr_len     = sizeof(MYSNMPAGENT_MIB2_SYSDESCR) - 1;
+static u8_t mysnmpagent_syscontact[256]         = MYSNMPAGENT_MIB2_SYSCONTACT;
+static u16_t mysnmpagent_syscontact_len         = sizeof(MYSNMPAGENT_MIB2_SYSCONTACT) - 1;
+static u8_t mysnmpagent_sysname[256]            = MYSNMPAGENT_MIB2_SYSNAME;
+static u16_t mysnmpagent_sysname_len            = sizeof(MYSNMPAGENT_MIB2_SYSNAME) - 1;
+static u8_t mysnmpagent_syslocation[256]        = MYSNMPAGENT_MIB2_SYSLOCATION;
+static u16_t mysnmpagent_syslocation_len        = sizeof(MYSNMPAGENT_MIB2_SYSLOCATION) - 1;
+
+#if SNMP_PROFILE
+static const char *const profile_pdu_names[SNMP_PROFILE_PDUS] = {
+    "get", "getnext", "getbulk", "set", "other"
+};
+static const char *const profile_phase_names[SNMP_PROFILE_PHASES] = {
+    "parse", "resolve", "get_value", "set_value", "threadsync", "encode", "v3_security", "sendto"
+};
+
+/* Print non-empty phase histograms, bucket n counts phases of [2^n, 2^(n+1)) ns */
+static void print_profile(void)
+{
+    for (int pdu = 0; pdu < SNMP_PROFILE_PDUS; pdu++) {
+        for (int phase = 0; phase < SNMP_PROFILE_PHASES; phase++) {
+            u32_t total = 0;
+
+            for (int bucket = 0; bucket < SNMP_PROFILE_BUCKETS; bucket++) {
+                total += snmp_profile[pdu][phase][bucket];
+            }
+            if (total == 0) {
+                continue;
+            }
+
+            printf("%s %s: %u\n", profile_pdu_names[pdu], profile_phase_names[phase], (unsigned) total);
+            for (int bucket = 0; bucket < SNMP_PROFILE_BUCKETS; bucket++) {
+                u32_t count = snmp_profile[pdu][phase][bucket];
+                if (count == 0) {
+                    continue;
+                }
+                if (bucket == SNMP_PROFILE_BUCKETS - 1) {
+                    printf("    >= %9lu ns: %u\n", 1UL << bucket, (unsigned) count);
+                } else {
+                    printf("    < %10lu ns: %u\n", 2UL << bucket, (unsigned) count);
+                }
+            }
+        }
+    }
+}
+#endif
+
+int main(int argc, char *argv[])
+{
+    /* Optional UDP port to receive SNMP requests on */
+    if (argc > 1) {
+        int port = atoi(argv[1]);
+        if (port <= 0 || port > 0xFFFF) {
+            fprintf(stderr, "Usage: %s [port]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+        snmp_posix_set_port((u16_t) port);
+    }
+
+    /* Bring up lwIP shims in place of lwIP stack */
+    sys_init();
+    tcpip_init();
+    netif_init();
+
+    /* Set up SNMP device enterprise OID */
+    snmp_set_device_enterprise_oid(&mysnmpagent_device_enterprise_oid);
+
+#ifdef MYSNMPAGENT_TRAP_DST_IP
+    /* Set up one SNMP trap destination */
+    snmp_trap_dst_enable(0, 1);
+
+    ip_addr_t ipaddr_trap_dst;
+    ipaddr_aton(mysnmpagent_trap_dst_ip, &ipaddr_trap_dst);
+    snmp_trap_dst_ip_set(0, &ipaddr_trap_dst);
+#endif
+
+    /* Enable authentication traps */
+    snmp_set_auth_traps_enabled(SNMP_AUTH_TRAPS_ENABLED);
+
+    /* Set up SNMP MIB-2 system group 1.3.6.1.2.1.1 */
+    snmp_mib2_set_sysdescr(mysnmpagent_sysdescr, &mysnmpagent_sysdescr_len);
+    snmp_mib2_set_syscontact(mysnmpagent_syscontact, &mysnmpagent_syscontact_len, sizeof(mysnmpagent_syscontact) - 1);
+    snmp_mib2_set_sysname(mysnmpagent_sysname, &mysnmpagent_sysname_len, sizeof(mysnmpagent_sysname) - 1);
+    snmp_mib2_set_syslocation(mysnmpagent_syslocation, &mysnmpagent_syslocation_len, sizeof(mysnmpagent_syslocation) - 1);
+
+    /* Set up SNMP community strings */
+    snmp_set_community(MYSNMPAGENT_COMMUNITY);
+    snmp_set_community_write(MYSNMPAGENT_COMMUNITY_WRITE);
+    snmp_set_community_trap(MYSNMPAGENT_COMMUNITY_TRAP);
+
+    /* Set up synchronization for MIB-2, same as on target */
+    snmp_threadsync_init(&snmp_mib2_lwip_locks, snmp_mib2_lwip_synchronizer);
+
+    /* Set up SNMP MIBs */
+    snmp_set_mibs(mysnmpagent_mibs, LWIP_ARRAYSIZE(mysnmpagent_mibs));
+
+    /* SNMP community names */
+    printf("SNMP community: %s\n", snmp_get_community());
+    printf("SNMP community for write-access: %s\n", snmp_get_community_write());
+    printf("SNMP community for sending traps: %s\n", snmp_get_community_trap());
+
+    /* Enable SNMP Agent running in separate threads */
+    snmp_init();
+
+#if SNMP_PROFILE
+    /* Console on stdin, until closed */
+    char line[64];
+    while (fgets(line, sizeof(line), stdin) != NULL) {
+        if (strncmp(line, "profile", 7) == 0) {
+            print_profile();
+        } else if (line[0] != '\n') {
+            printf("Commands: profile\n");
+        }
+        fflush(stdout);
+    }
+#endif
+
+    /* Idle in the main routine */
+    while (1) {
+        pause();
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2021, Nuvoton Technology Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+ * SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+ * OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ */
+
+/* Minimal lwIP lwip/arch.h for the Linux host port */
+
+#ifndef LWIP_HDR_ARCH_H
+#define LWIP_HDR_ARCH_H
+
+#include "arch/cc.h"
+
+#ifndef LITTLE_ENDIAN
+#define LITTLE_ENDIAN                   1234
+#endif
+
+#ifndef BIG_ENDIAN
+#define BIG_ENDIAN                      4321
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include <limits.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef uint8_t   u8_t;
+typedef int8_t    s8_t;
+typedef uint16_t  u16_t;
+typedef int16_t   s16_t;
+typedef uint32_t  u32_t;
+typedef int32_t   s32_t;
+typedef uint64_t  u64_t;
+typedef int64_t   s64_t;
+typedef uintptr_t mem_ptr_t;
+
+#define LWIP_HAVE_INT64                 1
+
+#define X8_F                            "02" PRIx8
+#define U16_F                           PRIu16
+#define S16_F                           PRId16
+#define X16_F                           PRIx16
+#define U32_F                           PRIu32
+#define S32_F                           PRId32
+#define X32_F                           PRIx32
+#define SZT_F                           "zu"
+
+#define LWIP_UNUSED_ARG(x)              (void)x
+#define LWIP_CONST_CAST(target_type, val) ((target_type)((ptrdiff_t)val))
+#define LWIP_ALIGNMENT_CAST(target_type, val) LWIP_CONST_CAST(target_type, val)
+#define LWIP_PTR_NUMERIC_CAST(target_type, val) LWIP_CONST_CAST(target_type, val)
+#define LWIP_PACKED_CAST(target_type, val) LWIP_CONST_CAST(target_type, val)
+
+#define LWIP_MEM_ALIGN_SIZE(size)       (((size) + MEM_ALIGNMENT - 1U) & ~(MEM_ALIGNMENT - 1U))
+#define LWIP_MEM_ALIGN_BUFFER(size)     (((size) + MEM_ALIGNMENT - 1U))
+#define LWIP_MEM_ALIGN(addr)            ((void *)(((mem_ptr_t)(addr) + MEM_ALIGNMENT - 1) & ~(mem_ptr_t)(MEM_ALIGNMENT - 1)))
+#define LWIP_DECLARE_MEMORY_ALIGNED(variable_name, size) u8_t variable_name[LWIP_MEM_ALIGN_BUFFER(size)]
+
+#define PACK_STRUCT_BEGIN
+#define PACK_STRUCT_END
+#define PACK_STRUCT_STRUCT              __attribute__((packed))
+#define PACK_STRUCT_FIELD(x)            x
+#define PACK_STRUCT_FLD_8(x)            x
+#define PACK_STRUCT_FLD_S(x)            x
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LWIP_HDR_ARCH_H */
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2021, Nuvoton Technology Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+ * SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+ * OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ */
+
+/* Minimal lwIP lwip/debug.h for the Linux host port */
+
+#ifndef LWIP_HDR_DEBUG_H
+#define LWIP_HDR_DEBUG_H
+
+#include "lwip/arch.h"
+#include "lwip/opt.h"
+
+#define LWIP_DBG_LEVEL_ALL              0x00
+#define LWIP_DBG_LEVEL_WARNING          0x01
+#define LWIP_DBG_LEVEL_SERIOUS          0x02
+#define LWIP_DBG_LEVEL_SEVERE           0x03
+#define LWIP_DBG_MASK_LEVEL             0x03
+#define LWIP_DBG_LEVEL_OFF              LWIP_DBG_LEVEL_ALL
+
+#define LWIP_DBG_ON                     0x80U
+#define LWIP_DBG_OFF                    0x00U
+
+#define LWIP_DBG_TRACE                  0x40U
+#define LWIP_DBG_STATE                  0x20U
+#define LWIP_DBG_FRESH                  0x10U
+#define LWIP_DBG_HALT                   0x08U
+
+#ifndef LWIP_NOASSERT
+#define LWIP_ASSERT(message, assertion) do { if (!(assertion)) { \
+  LWIP_PLATFORM_ASSERT(message); }} while (0)
+#else
+#define LWIP_ASSERT(message, assertion)
+#endif
+
+#define LWIP_ERROR(message, expression, handler) do { if (!(expression)) { \
+  LWIP_PLATFORM_DIAG(("%s\n", message)); handler;}} while (0)
+
+#ifdef LWIP_DEBUG
+#define LWIP_DEBUGF(debug, message) do { \
+                               if ((debug) & LWIP_DBG_ON) { \
+                                 LWIP_PLATFORM_DIAG(message); \
+                               } \
+                             } while (0)
+#else
+#define LWIP_DEBUGF(debug, message)
+#endif
+
+#endif /* LWIP_HDR_DEBUG_H */
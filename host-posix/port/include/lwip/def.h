@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2021, Nuvoton Technology Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+ * SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+ * OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ */
+
+/* Minimal lwIP lwip/def.h for the Linux host port */
+
+#ifndef LWIP_HDR_DEF_H
+#define LWIP_HDR_DEF_H
+
+#include "lwip/arch.h"
+#include "lwip/opt.h"
+
+#include <string.h>
+#include <arpa/inet.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LWIP_MAX(x , y)                 (((x) > (y)) ? (x) : (y))
+#define LWIP_MIN(x , y)                 (((x) < (y)) ? (x) : (y))
+
+#define LWIP_ARRAYSIZE(x)               (sizeof(x)/sizeof((x)[0]))
+
+#define LWIP_MAKEU32(a,b,c,d)           (((u32_t)((a) & 0xff) << 24) | \
+                                         ((u32_t)((b) & 0xff) << 16) | \
+                                         ((u32_t)((c) & 0xff) << 8)  | \
+                                          (u32_t)((d) & 0xff))
+
+#define lwip_htons(x)                   htons(x)
+#define lwip_ntohs(x)                   ntohs(x)
+#define lwip_htonl(x)                   htonl(x)
+#define lwip_ntohl(x)                   ntohl(x)
+
+#if BYTE_ORDER == BIG_ENDIAN
+#define PP_HTONS(x)                     ((u16_t)(x))
+#define PP_HTONL(x)                     ((u32_t)(x))
+#else
+#define PP_HTONS(x)                     ((u16_t)((((x) & (u16_t)0x00ffU) << 8) | (((x) & (u16_t)0xff00U) >> 8)))
+#define PP_HTONL(x)                     ((((x) & (u32_t)0x000000ffUL) << 24) | \
+                                         (((x) & (u32_t)0x0000ff00UL) <<  8) | \
+                                         (((x) & (u32_t)0x00ff0000UL) >>  8) | \
+                                         (((x) & (u32_t)0xff000000UL) >> 24))
+#endif
+#define PP_NTOHS(x)                     PP_HTONS(x)
+#define PP_NTOHL(x)                     PP_HTONL(x)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LWIP_HDR_DEF_H */
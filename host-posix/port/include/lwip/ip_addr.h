@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2021, Nuvoton Technology Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+ * SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+ * OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ */
+
+/* Minimal lwIP lwip/ip_addr.h for the Linux host port
+ *
+ * IPv4 only, same as lwIP built with LWIP_IPV4=1 and LWIP_IPV6=0, where
+ * ip_addr_t collapses to ip4_addr_t.
+ */
+
+#ifndef LWIP_HDR_IP_ADDR_H
+#define LWIP_HDR_IP_ADDR_H
+
+#include "lwip/opt.h"
+#include "lwip/def.h"
+
+#if LWIP_IPV6
+#error "Linux host port supports IPv4 only"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct ip4_addr {
+  u32_t addr;
+};
+typedef struct ip4_addr ip4_addr_t;
+
+typedef ip4_addr_t ip_addr_t;
+
+enum lwip_ip_addr_type {
+  IPADDR_TYPE_V4 =   0U,
+  IPADDR_TYPE_V6 =   6U,
+  IPADDR_TYPE_ANY = 46U
+};
+
+#define IPADDR_NONE                     ((u32_t)0xffffffffUL)
+#define IPADDR_LOOPBACK                 ((u32_t)0x7f000001UL)
+#define IPADDR_ANY                      ((u32_t)0x00000000UL)
+#define IPADDR_BROADCAST                ((u32_t)0xffffffffUL)
+
+#define IPADDR4_INIT(u32val)            { u32val }
+#define IPADDR4_INIT_BYTES(a,b,c,d)     IPADDR4_INIT(PP_HTONL(LWIP_MAKEU32(a,b,c,d)))
+#define IPADDR_ANY_TYPE_INIT            IPADDR4_INIT(IPADDR_ANY)
+
+#define IP4_ADDR(ipaddr, a,b,c,d)       (ipaddr)->addr = PP_HTONL(LWIP_MAKEU32(a,b,c,d))
+#define ip4_addr_copy(dest, src)        ((dest).addr = (src).addr)
+#define ip4_addr_set(dest, src)         ((dest)->addr = ((src) == NULL ? 0 : (src)->addr))
+#define ip4_addr_set_zero(ipaddr)       ((ipaddr)->addr = 0)
+#define ip4_addr_set_any(ipaddr)        ((ipaddr)->addr = IPADDR_ANY)
+#define ip4_addr_set_u32(dest_ipaddr, src_u32) ((dest_ipaddr)->addr = (src_u32))
+#define ip4_addr_get_u32(src_ipaddr)    ((src_ipaddr)->addr)
+#define ip4_addr_get_byte(ipaddr, idx) (((const u8_t*)(&(ipaddr)->addr))[idx])
+#define ip4_addr1(ipaddr)               ip4_addr_get_byte(ipaddr, 0)
+#define ip4_addr2(ipaddr)               ip4_addr_get_byte(ipaddr, 1)
+#define ip4_addr3(ipaddr)               ip4_addr_get_byte(ipaddr, 2)
+#define ip4_addr4(ipaddr)               ip4_addr_get_byte(ipaddr, 3)
+#define ip4_addr_get_network(target, host, netmask) do { ((target)->addr = ((host)->addr) & ((netmask)->addr)); } while(0)
+#define ip4_addr_cmp(addr1, addr2)      ((addr1)->addr == (addr2)->addr)
+#define ip4_addr_isany_val(addr1)       ((addr1).addr == IPADDR_ANY)
+#define ip4_addr_isany(addr1)           ((addr1) == NULL || ip4_addr_isany_val(*(addr1)))
+
+#define IP_IS_V4_VAL(ipaddr)            1
+#define IP_IS_V6_VAL(ipaddr)            0
+#define IP_IS_V4(ipaddr)                1
+#define IP_IS_V6(ipaddr)                0
+#define IP_IS_ANY_TYPE_VAL(ipaddr)      0
+#define IP_SET_TYPE_VAL(ipaddr, iptype)
+#define IP_SET_TYPE(ipaddr, iptype)
+#define IP_GET_TYPE(ipaddr)             IPADDR_TYPE_V4
+#define ip_2_ip4(ipaddr)                (ipaddr)
+
+#define IP_ADDR4(ipaddr,a,b,c,d)        IP4_ADDR(ipaddr,a,b,c,d)
+#define ip_addr_copy(dest, src)         ip4_addr_copy(dest, src)
+#define ip_addr_set(dest, src)          ip4_addr_set(dest, src)
+#define ip_addr_set_zero(ipaddr)        ip4_addr_set_zero(ipaddr)
+#define ip_addr_set_any(is_ipv6, ipaddr) ip4_addr_set_any(ipaddr)
+#define ip_addr_cmp(addr1, addr2)       ip4_addr_cmp(addr1, addr2)
+#define ip_addr_isany(ipaddr)           ip4_addr_isany(ipaddr)
+#define ip_addr_isany_val(ipaddr)       ip4_addr_isany_val(ipaddr)
+#define ipaddr_ntoa(ipaddr)             ip4addr_ntoa(ipaddr)
+#define ipaddr_ntoa_r(ipaddr, buf, buflen) ip4addr_ntoa_r(ipaddr, buf, buflen)
+#define ipaddr_aton(cp, addr)           ip4addr_aton(cp, addr)
+
+int ip4addr_aton(const char *cp, ip4_addr_t *addr);
+char *ip4addr_ntoa(const ip4_addr_t *addr);
+char *ip4addr_ntoa_r(const ip4_addr_t *addr, char *buf, int buflen);
+
+extern const ip_addr_t ip_addr_any;
+extern const ip_addr_t ip_addr_broadcast;
+
+#define IP_ADDR_ANY                     IP4_ADDR_ANY
+#define IP4_ADDR_ANY                    (&ip_addr_any)
+#define IP4_ADDR_ANY4                   (&ip_addr_any)
+#define IP_ANY_TYPE                     IP_ADDR_ANY
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LWIP_HDR_IP_ADDR_H */
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2021, Nuvoton Technology Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+ * SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+ * OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ */
+
+/* Minimal lwIP lwip/netif.h for the Linux host port
+ *
+ * Just enough for the MIB-2 interfaces and IP groups. The host shims
+ * provide one loopback interface.
+ */
+
+#ifndef LWIP_HDR_NETIF_H
+#define LWIP_HDR_NETIF_H
+
+#include "lwip/opt.h"
+#include "lwip/err.h"
+#include "lwip/ip_addr.h"
+#include "lwip/snmp.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define NETIF_MAX_HWADDR_LEN            6U
+
+#define NETIF_FLAG_UP                   0x01U
+#define NETIF_FLAG_BROADCAST            0x02U
+#define NETIF_FLAG_LINK_UP              0x04U
+
+struct netif {
+  struct netif *next;
+  ip_addr_t ip_addr;
+  ip_addr_t netmask;
+  ip_addr_t gw;
+  u16_t mtu;
+  u8_t hwaddr[NETIF_MAX_HWADDR_LEN];
+  u8_t hwaddr_len;
+  u8_t flags;
+  char name[2];
+  u8_t num;
+  u8_t link_type;
+  u32_t link_speed;
+  u32_t ts;
+  struct stats_mib2_netif_ctrs mib2_counters;
+};
+
+extern struct netif *netif_list;
+extern struct netif *netif_default;
+
+#define NETIF_FOREACH(netif)            for ((netif) = netif_list; (netif) != NULL; (netif) = (netif)->next)
+
+#define netif_is_up(netif)              (((netif)->flags & NETIF_FLAG_UP) ? (u8_t)1 : (u8_t)0)
+#define netif_is_link_up(netif)         (((netif)->flags & NETIF_FLAG_LINK_UP) ? (u8_t)1 : (u8_t)0)
+#define netif_get_index(netif)          ((u8_t)((netif)->num + 1))
+
+#define netif_ip4_addr(netif)           ((const ip4_addr_t *)&((netif)->ip_addr))
+#define netif_ip4_netmask(netif)        ((const ip4_addr_t *)&((netif)->netmask))
+#define netif_ip4_gw(netif)             ((const ip4_addr_t *)&((netif)->gw))
+
+void netif_init(void);
+void netif_set_up(struct netif *netif);
+void netif_set_down(struct netif *netif);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LWIP_HDR_NETIF_H */
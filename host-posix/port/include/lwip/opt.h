@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2021, Nuvoton Technology Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+ * SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+ * OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ */
+
+/* Minimal lwIP lwip/opt.h for the Linux host port
+ *
+ * Only the options referenced by lwip-snmp and the host shims are defaulted
+ * here. Everything else comes from lwipopts.h.
+ */
+
+#ifndef LWIP_HDR_OPT_H
+#define LWIP_HDR_OPT_H
+
+#include "lwipopts.h"
+#include "lwip/debug.h"
+
+#ifndef NO_SYS
+#define NO_SYS                          0
+#endif
+
+#ifndef SMEMCPY
+#define SMEMCPY(dst,src,len)            memcpy(dst,src,len)
+#endif
+
+#ifndef MEMCPY
+#define MEMCPY(dst,src,len)             memcpy(dst,src,len)
+#endif
+
+#ifndef MEM_ALIGNMENT
+#define MEM_ALIGNMENT                   8
+#endif
+
+#ifndef LWIP_IPV4
+#define LWIP_IPV4                       1
+#endif
+
+#ifndef LWIP_IPV6
+#define LWIP_IPV6                       0
+#endif
+
+#ifndef LWIP_UDP
+#define LWIP_UDP                        1
+#endif
+
+#ifndef LWIP_TCP
+#define LWIP_TCP                        0
+#endif
+
+#ifndef LWIP_ICMP
+#define LWIP_ICMP                       0
+#endif
+
+#ifndef LWIP_ARP
+#define LWIP_ARP                        0
+#endif
+
+#ifndef IP_FORWARD
+#define IP_FORWARD                      0
+#endif
+
+#ifndef IP_REASSEMBLY
+#define IP_REASSEMBLY                   0
+#endif
+
+#ifndef IP_REASS_MAXAGE
+#define IP_REASS_MAXAGE                 15
+#endif
+
+#ifndef IP_DEFAULT_TTL
+#define IP_DEFAULT_TTL                  255
+#endif
+
+#ifndef LWIP_STATS
+#define LWIP_STATS                      1
+#endif
+
+#ifndef MIB2_STATS
+#define MIB2_STATS                      0
+#endif
+
+#ifndef LWIP_TCPIP_CORE_LOCKING
+#define LWIP_TCPIP_CORE_LOCKING         1
+#endif
+
+#ifndef LWIP_ASSERT_CORE_LOCKED
+#define LWIP_ASSERT_CORE_LOCKED()
+#endif
+
+#ifndef LWIP_SUPPORT_CUSTOM_PBUF
+#define LWIP_SUPPORT_CUSTOM_PBUF        0
+#endif
+
+#ifndef PBUF_LINK_HLEN
+#define PBUF_LINK_HLEN                  14
+#endif
+
+#ifndef PBUF_LINK_ENCAPSULATION_HLEN
+#define PBUF_LINK_ENCAPSULATION_HLEN    0
+#endif
+
+#ifndef PBUF_POOL_BUFSIZE
+#define PBUF_POOL_BUFSIZE               1536
+#endif
+
+#ifndef DEFAULT_THREAD_STACKSIZE
+#define DEFAULT_THREAD_STACKSIZE        0
+#endif
+
+#ifndef DEFAULT_THREAD_PRIO
+#define DEFAULT_THREAD_PRIO             0
+#endif
+
+#ifndef LWIP_MIB2_CALLBACKS
+#define LWIP_MIB2_CALLBACKS             1
+#endif
+
+#endif /* LWIP_HDR_OPT_H */
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2021, Nuvoton Technology Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+ * SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+ * OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ */
+
+/* Minimal lwIP lwip/sys.h for the Linux host port
+ *
+ * OS abstraction over POSIX threads. SYS_ARCH_PROTECT is emulated with one
+ * global recursive mutex, which is coarser than interrupt masking on target
+ * but has the same semantics.
+ */
+
+#ifndef LWIP_HDR_SYS_H
+#define LWIP_HDR_SYS_H
+
+#include "lwip/opt.h"
+#include "lwip/err.h"
+
+#include <pthread.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SYS_ARCH_TIMEOUT                0xffffffffUL
+
+typedef pthread_mutex_t sys_mutex_t;
+
+struct sys_sem {
+  pthread_mutex_t mutex;
+  pthread_cond_t cond;
+  u32_t count;
+  u8_t valid;
+};
+typedef struct sys_sem sys_sem_t;
+
+typedef pthread_t sys_thread_t;
+typedef void (*lwip_thread_fn)(void *arg);
+
+typedef int sys_prot_t;
+
+err_t sys_mutex_new(sys_mutex_t *mutex);
+void sys_mutex_lock(sys_mutex_t *mutex);
+void sys_mutex_unlock(sys_mutex_t *mutex);
+void sys_mutex_free(sys_mutex_t *mutex);
+
+err_t sys_sem_new(sys_sem_t *sem, u8_t count);
+void sys_sem_signal(sys_sem_t *sem);
+u32_t sys_arch_sem_wait(sys_sem_t *sem, u32_t timeout);
+void sys_sem_free(sys_sem_t *sem);
+#define sys_sem_wait(sem)               sys_arch_sem_wait(sem, 0)
+#define sys_sem_valid(sem)              (((sem) != NULL) && (sem)->valid)
+#define sys_sem_set_invalid(sem)        do { if ((sem) != NULL) { (sem)->valid = 0; }} while (0)
+
+sys_thread_t sys_thread_new(const char *name, lwip_thread_fn thread, void *arg, int stacksize, int prio);
+
+sys_prot_t sys_arch_protect(void);
+void sys_arch_unprotect(sys_prot_t pval);
+
+#define SYS_ARCH_DECL_PROTECT(lev)      sys_prot_t lev
+#define SYS_ARCH_PROTECT(lev)           lev = sys_arch_protect()
+#define SYS_ARCH_UNPROTECT(lev)         sys_arch_unprotect(lev)
+
+void sys_init(void);
+u32_t sys_now(void);
+void sys_msleep(u32_t ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LWIP_HDR_SYS_H */
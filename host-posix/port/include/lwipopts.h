@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2021, Nuvoton Technology Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+ * SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+ * OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ */
+
+/* lwIP options for the Linux host port
+ *
+ * Mirror SNMP-related macros in mbed_app.json so that the message engine
+ * built on the host is configured the same as on target. Only IPv4 is
+ * supported by the host shims.
+ */
+
+#ifndef LWIP_LWIPOPTS_H
+#define LWIP_LWIPOPTS_H
+
+#define NO_SYS                          0
+#define LWIP_IPV4                       1
+#define LWIP_IPV6                       0
+#define LWIP_UDP                        1
+#define LWIP_TCP                        0
+#define LWIP_ICMP                       0
+#define LWIP_ARP                        0
+#define IP_FORWARD                      0
+#define LWIP_STATS                      1
+#define LWIP_TCPIP_CORE_LOCKING         1
+
+#define LWIP_SNMP                       1
+#define SNMP_USE_NETCONN                1
+#define SNMP_USE_RAW                    0
+#define SNMP_STACK_SIZE                 0
+#define MIB2_STATS                      1
+#define LWIP_SUPPORT_CUSTOM_PBUF        1
+#define SNMP_OUTBOUND_PBUF_POOL_SIZE    2
+#define SNMP_WORKER_THREADS             2
+#define SNMP_RECV_BATCH_SIZE            4
+#define SNMP_TRAP_QUEUE_SIZE            8
+#define SNMP_RESPONSE_CACHE_SIZE        2
+/* No admission control, a benchmark client is one single source */
+#define SNMP_RATE_LIMIT_SOURCES         0
+#define SNMP_GETBULK_CURSORS            8
+#define SNMP_TABLE_NEXT_CELLS           8
+#define SNMP_WALK_CACHE_SIZE            4
+#define SNMP_VALUE_CACHE_SIZE           32
+#define SNMP_LWIP_MIB2_CACHE_TTL        1000
+#define SNMP_SET_VARBIND_INDEX_SIZE     8
+#define SNMP_PROFILE                    1
+#define SNMP_RESPONSE_HEADER_TEMPLATES  1
+#define SNMP_SORTED_TREE_NODES          1
+#define SNMP_MIB_REGISTRY_SIZE          8
+#define SNMP_MEMORY_BARRIER()           __sync_synchronize()
+
+/* Per-packet debug output would dominate any measurement */
+#ifndef SNMP_DEBUG
+#define SNMP_DEBUG                      LWIP_DBG_OFF
+#endif
+#ifndef SNMP_MIB_DEBUG
+#define SNMP_MIB_DEBUG                  LWIP_DBG_OFF
+#endif
+
+#endif /* LWIP_LWIPOPTS_H */
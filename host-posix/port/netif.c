@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2021, Nuvoton Technology Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+ * SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+ * OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ */
+
+/* Minimal lwIP network interface and stats for the Linux host port
+ *
+ * Expose one loopback interface to the MIB-2 interfaces and IP groups, so
+ * walking their tables exercises the same code paths as on target.
+ */
+
+#include "lwip/opt.h"
+#include "lwip/netif.h"
+#include "lwip/udp.h"
+#include "lwip/stats.h"
+#include "lwip/sys.h"
+
+#if LWIP_STATS
+struct stats_ lwip_stats;
+#endif
+
+struct udp_pcb *udp_pcbs;
+
+static struct netif loop_netif;
+
+struct netif *netif_list;
+struct netif *netif_default;
+
+void
+netif_init(void)
+{
+    IP4_ADDR(&loop_netif.ip_addr, 127, 0, 0, 1);
+    IP4_ADDR(&loop_netif.netmask, 255, 0, 0, 0);
+    IP4_ADDR(&loop_netif.gw, 127, 0, 0, 1);
+    loop_netif.mtu = 0;
+    loop_netif.name[0] = 'l';
+    loop_netif.name[1] = 'o';
+    loop_netif.num = 0;
+    loop_netif.link_type = snmp_ifType_softwareLoopback;
+    loop_netif.link_speed = 0;
+    loop_netif.ts = 0;
+    loop_netif.flags = NETIF_FLAG_UP | NETIF_FLAG_LINK_UP;
+
+    netif_list = &loop_netif;
+    netif_default = &loop_netif;
+}
+
+void
+netif_set_up(struct netif *netif)
+{
+    if (!(netif->flags & NETIF_FLAG_UP)) {
+        netif->flags |= NETIF_FLAG_UP;
+        netif->ts = sys_now() / 10;
+    }
+}
+
+void
+netif_set_down(struct netif *netif)
+{
+    if (netif->flags & NETIF_FLAG_UP) {
+        netif->flags &= ~NETIF_FLAG_UP;
+        netif->ts = sys_now() / 10;
+    }
+}
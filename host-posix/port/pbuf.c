@@ -0,0 +1,370 @@
+/*
+ * Copyright (c) 2021, Nuvoton Technology Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+ * SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+ * OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ */
+
+/* Minimal lwIP pbuf implementation for the Linux host port
+ *
+ * PBUF_RAM pbufs are allocated from the C heap in one piece, pbuf struct
+ * followed by payload. PBUF_REF/PBUF_ROM pbufs just carry the pointer.
+ * Layer header space is not reserved, since nothing is prepended on host.
+ */
+
+#include "lwip/opt.h"
+#include "lwip/pbuf.h"
+#include "lwip/sys.h"
+
+#include <string.h>
+
+#define SIZEOF_STRUCT_PBUF              LWIP_MEM_ALIGN_SIZE(sizeof(struct pbuf))
+
+static void
+pbuf_init_alloced_pbuf(struct pbuf *p, void *payload, u16_t tot_len, u16_t len, pbuf_type type, u8_t flags)
+{
+    p->next = NULL;
+    p->payload = payload;
+    p->tot_len = tot_len;
+    p->len = len;
+    p->type_internal = (u8_t) type;
+    p->flags = flags;
+    p->ref = 1;
+    p->if_idx = 0;
+}
+
+struct pbuf *
+pbuf_alloc(pbuf_layer layer, u16_t length, pbuf_type type)
+{
+    struct pbuf *p;
+
+    LWIP_UNUSED_ARG(layer);
+
+    switch (type) {
+        case PBUF_REF:
+        case PBUF_ROM:
+            return pbuf_alloc_reference(NULL, length, type);
+
+        case PBUF_RAM:
+        case PBUF_POOL:
+            p = (struct pbuf *) malloc(SIZEOF_STRUCT_PBUF + LWIP_MEM_ALIGN_SIZE(length));
+            if (p == NULL) {
+                return NULL;
+            }
+            pbuf_init_alloced_pbuf(p, (u8_t *) p + SIZEOF_STRUCT_PBUF, length, length, PBUF_RAM, 0);
+            return p;
+
+        default:
+            LWIP_ASSERT("pbuf_alloc: erroneous type", 0);
+            return NULL;
+    }
+}
+
+struct pbuf *
+pbuf_alloc_reference(void *payload, u16_t length, pbuf_type type)
+{
+    struct pbuf *p;
+
+    LWIP_ASSERT("invalid pbuf_type", (type == PBUF_REF) || (type == PBUF_ROM));
+
+    p = (struct pbuf *) malloc(sizeof(struct pbuf));
+    if (p == NULL) {
+        return NULL;
+    }
+    pbuf_init_alloced_pbuf(p, payload, length, length, type, 0);
+    return p;
+}
+
+#if LWIP_SUPPORT_CUSTOM_PBUF
+struct pbuf *
+pbuf_alloced_custom(pbuf_layer l, u16_t length, pbuf_type type, struct pbuf_custom *p,
+                    void *payload_mem, u16_t payload_mem_len)
+{
+    LWIP_UNUSED_ARG(l);
+
+    if (length > payload_mem_len) {
+        return NULL;
+    }
+
+    pbuf_init_alloced_pbuf(&p->pbuf, payload_mem, length, length, type, PBUF_FLAG_IS_CUSTOM);
+    return &p->pbuf;
+}
+#endif /* LWIP_SUPPORT_CUSTOM_PBUF */
+
+void
+pbuf_realloc(struct pbuf *p, u16_t new_len)
+{
+    struct pbuf *q;
+    u16_t rem_len;
+    u16_t shrink;
+
+    LWIP_ASSERT("pbuf_realloc: p != NULL", p != NULL);
+
+    /* Only shrinking is supported, same as lwIP */
+    if (new_len >= p->tot_len) {
+        return;
+    }
+
+    shrink = (u16_t)(p->tot_len - new_len);
+    rem_len = new_len;
+    q = p;
+    while (rem_len > q->len) {
+        rem_len = (u16_t)(rem_len - q->len);
+        q->tot_len = (u16_t)(q->tot_len - shrink);
+        q = q->next;
+    }
+
+    q->len = rem_len;
+    q->tot_len = q->len;
+
+    if (q->next != NULL) {
+        pbuf_free(q->next);
+    }
+    q->next = NULL;
+}
+
+u8_t
+pbuf_free(struct pbuf *p)
+{
+    u8_t count = 0;
+
+    if (p == NULL) {
+        LWIP_ASSERT("p != NULL", p != NULL);
+        return 0;
+    }
+
+    while (p != NULL) {
+        struct pbuf *q;
+        u16_t ref;
+        SYS_ARCH_DECL_PROTECT(old_level);
+
+        SYS_ARCH_PROTECT(old_level);
+        LWIP_ASSERT("pbuf_free: p->ref > 0", p->ref > 0);
+        ref = --(p->ref);
+        SYS_ARCH_UNPROTECT(old_level);
+
+        if (ref != 0) {
+            break;
+        }
+
+        q = p->next;
+#if LWIP_SUPPORT_CUSTOM_PBUF
+        if ((p->flags & PBUF_FLAG_IS_CUSTOM) != 0) {
+            struct pbuf_custom *pc = (struct pbuf_custom *) p;
+            LWIP_ASSERT("pc->custom_free_function != NULL", pc->custom_free_function != NULL);
+            pc->custom_free_function(p);
+        } else
+#endif /* LWIP_SUPPORT_CUSTOM_PBUF */
+        {
+            free(p);
+        }
+        count++;
+        p = q;
+    }
+
+    return count;
+}
+
+void
+pbuf_ref(struct pbuf *p)
+{
+    if (p != NULL) {
+        SYS_ARCH_DECL_PROTECT(old_level);
+        SYS_ARCH_PROTECT(old_level);
+        p->ref++;
+        SYS_ARCH_UNPROTECT(old_level);
+    }
+}
+
+u16_t
+pbuf_clen(const struct pbuf *p)
+{
+    u16_t len = 0;
+
+    while (p != NULL) {
+        ++len;
+        p = p->next;
+    }
+    return len;
+}
+
+void
+pbuf_cat(struct pbuf *h, struct pbuf *t)
+{
+    struct pbuf *p;
+
+    LWIP_ERROR("(h != NULL) && (t != NULL) (programmer violates API)",
+               ((h != NULL) && (t != NULL)), return;);
+
+    for (p = h; p->next != NULL; p = p->next) {
+        p->tot_len = (u16_t)(p->tot_len + t->tot_len);
+    }
+    p->tot_len = (u16_t)(p->tot_len + t->tot_len);
+    p->next = t;
+}
+
+void
+pbuf_chain(struct pbuf *h, struct pbuf *t)
+{
+    pbuf_cat(h, t);
+    pbuf_ref(t);
+}
+
+err_t
+pbuf_copy(struct pbuf *p_to, const struct pbuf *p_from)
+{
+    u16_t offset = 0;
+
+    LWIP_ERROR("pbuf_copy: invalid source", p_from != NULL, return ERR_ARG;);
+    LWIP_ERROR("pbuf_copy: target not big enough to hold source",
+               (p_to != NULL) && (p_to->tot_len >= p_from->tot_len), return ERR_ARG;);
+
+    for (; p_from != NULL; p_from = p_from->next) {
+        err_t err = pbuf_take_at(p_to, p_from->payload, p_from->len, offset);
+        if (err != ERR_OK) {
+            return err;
+        }
+        offset = (u16_t)(offset + p_from->len);
+    }
+    return ERR_OK;
+}
+
+u16_t
+pbuf_copy_partial(const struct pbuf *buf, void *dataptr, u16_t len, u16_t offset)
+{
+    const struct pbuf *p;
+    u16_t left = 0;
+    u16_t buf_copy_len;
+    u16_t copied_total = 0;
+
+    LWIP_ERROR("pbuf_copy_partial: invalid buf", (buf != NULL), return 0;);
+    LWIP_ERROR("pbuf_copy_partial: invalid dataptr", (dataptr != NULL), return 0;);
+
+    for (p = buf; len != 0 && p != NULL; p = p->next) {
+        if ((offset != 0) && (offset >= p->len)) {
+            offset = (u16_t)(offset - p->len);
+        } else {
+            buf_copy_len = (u16_t)(p->len - offset);
+            if (buf_copy_len > len) {
+                buf_copy_len = len;
+            }
+            MEMCPY(&((char *) dataptr)[left], &((char *) p->payload)[offset], buf_copy_len);
+            copied_total = (u16_t)(copied_total + buf_copy_len);
+            left = (u16_t)(left + buf_copy_len);
+            len = (u16_t)(len - buf_copy_len);
+            offset = 0;
+        }
+    }
+    return copied_total;
+}
+
+void *
+pbuf_get_contiguous(const struct pbuf *p, void *buffer, size_t bufsize, u16_t len, u16_t offset)
+{
+    const struct pbuf *q;
+    u16_t out_offset;
+
+    LWIP_ERROR("pbuf_get_contiguous: invalid buf", (p != NULL), return NULL;);
+    LWIP_ERROR("pbuf_get_contiguous: invalid dataptr", (buffer != NULL), return NULL;);
+    LWIP_ERROR("pbuf_get_contiguous: invalid dataptr", (bufsize >= len), return NULL;);
+
+    q = pbuf_skip((struct pbuf *) p, offset, &out_offset);
+    if (q != NULL) {
+        if (q->len >= (out_offset + len)) {
+            /* all data in this pbuf, return zero-copy */
+            return (u8_t *) q->payload + out_offset;
+        }
+        /* need to copy */
+        if (pbuf_copy_partial(q, buffer, len, out_offset) != len) {
+            /* copying failed: pbuf is too short */
+            return NULL;
+        }
+        return buffer;
+    }
+    /* pbuf is too short (offset does not fit in) */
+    return NULL;
+}
+
+struct pbuf *
+pbuf_skip(struct pbuf *in, u16_t in_offset, u16_t *out_offset)
+{
+    u16_t offset_left = in_offset;
+    struct pbuf *q = in;
+
+    /* get the correct pbuf */
+    while ((q != NULL) && (q->len <= offset_left)) {
+        offset_left = (u16_t)(offset_left - q->len);
+        q = q->next;
+    }
+    if (out_offset != NULL) {
+        *out_offset = offset_left;
+    }
+    return q;
+}
+
+err_t
+pbuf_take(struct pbuf *buf, const void *dataptr, u16_t len)
+{
+    return pbuf_take_at(buf, dataptr, len, 0);
+}
+
+err_t
+pbuf_take_at(struct pbuf *buf, const void *dataptr, u16_t len, u16_t offset)
+{
+    u16_t target_offset;
+    struct pbuf *q = pbuf_skip(buf, offset, &target_offset);
+    u16_t copied_total = 0;
+
+    LWIP_ERROR("pbuf_take_at: invalid buf", (buf != NULL), return ERR_ARG;);
+    LWIP_ERROR("pbuf_take_at: invalid dataptr", ((dataptr != NULL) || (len == 0)), return ERR_ARG;);
+
+    /* return requested data if pbuf is OK */
+    if ((q == NULL) || (q->tot_len < target_offset + len)) {
+        return ERR_MEM;
+    }
+
+    for (; (q != NULL) && (copied_total < len); q = q->next) {
+        u16_t buf_copy_len = (u16_t)(q->len - target_offset);
+        if (buf_copy_len > (u16_t)(len - copied_total)) {
+            buf_copy_len = (u16_t)(len - copied_total);
+        }
+        MEMCPY((u8_t *) q->payload + target_offset, (const u8_t *) dataptr + copied_total, buf_copy_len);
+        copied_total = (u16_t)(copied_total + buf_copy_len);
+        target_offset = 0;
+    }
+    return ERR_OK;
+}
+
+struct pbuf *
+pbuf_clone(pbuf_layer layer, pbuf_type type, struct pbuf *p)
+{
+    struct pbuf *q = pbuf_alloc(layer, p->tot_len, type);
+    if (q == NULL) {
+        return NULL;
+    }
+    if (pbuf_copy(q, p) != ERR_OK) {
+        pbuf_free(q);
+        return NULL;
+    }
+    return q;
+}
@@ -0,0 +1,260 @@
+/*
+ * Copyright (c) 2021, Nuvoton Technology Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+ * SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+ * OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ */
+
+/* Minimal lwIP OS abstraction for the Linux host port */
+
+#define _GNU_SOURCE
+
+#include "lwip/opt.h"
+#include "lwip/def.h"
+#include "lwip/sys.h"
+#include "lwip/tcpip.h"
+#include "lwip/apps/snmp_core.h"
+
+#include <limits.h>
+#include <time.h>
+
+/* Global lock emulating SYS_ARCH_PROTECT, recursive like nested interrupt masking */
+static pthread_mutex_t sys_arch_protect_mutex;
+
+#if LWIP_TCPIP_CORE_LOCKING
+sys_mutex_t lock_tcpip_core;
+#endif
+
+void
+sys_init(void)
+{
+    pthread_mutexattr_t attr;
+
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&sys_arch_protect_mutex, &attr);
+    pthread_mutexattr_destroy(&attr);
+}
+
+void
+tcpip_init(void)
+{
+#if LWIP_TCPIP_CORE_LOCKING
+    sys_mutex_new(&lock_tcpip_core);
+#endif
+}
+
+sys_prot_t
+sys_arch_protect(void)
+{
+    pthread_mutex_lock(&sys_arch_protect_mutex);
+    return 0;
+}
+
+void
+sys_arch_unprotect(sys_prot_t pval)
+{
+    LWIP_UNUSED_ARG(pval);
+    pthread_mutex_unlock(&sys_arch_protect_mutex);
+}
+
+u32_t
+sys_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (u32_t)(ts.tv_sec * 1000 + ts.tv_nsec / 1000000);
+}
+
+void
+sys_msleep(u32_t ms)
+{
+    struct timespec ts;
+
+    ts.tv_sec = ms / 1000;
+    ts.tv_nsec = (long)(ms % 1000) * 1000000L;
+    while (nanosleep(&ts, &ts) != 0) {
+    }
+}
+
+#if LWIP_SNMP && SNMP_PROFILE
+/* Profile ticks are nanoseconds of the monotonic clock, wrapping every ~4.3 s */
+u32_t
+snmp_profile_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (u32_t)((u64_t)ts.tv_sec * 1000000000u + (u64_t)ts.tv_nsec);
+}
+#endif
+
+err_t
+sys_mutex_new(sys_mutex_t *mutex)
+{
+    return (pthread_mutex_init(mutex, NULL) == 0) ? ERR_OK : ERR_MEM;
+}
+
+void
+sys_mutex_lock(sys_mutex_t *mutex)
+{
+    pthread_mutex_lock(mutex);
+}
+
+void
+sys_mutex_unlock(sys_mutex_t *mutex)
+{
+    pthread_mutex_unlock(mutex);
+}
+
+void
+sys_mutex_free(sys_mutex_t *mutex)
+{
+    pthread_mutex_destroy(mutex);
+}
+
+err_t
+sys_sem_new(sys_sem_t *sem, u8_t count)
+{
+    pthread_condattr_t attr;
+
+    if (pthread_mutex_init(&sem->mutex, NULL) != 0) {
+        return ERR_MEM;
+    }
+
+    /* Timed wait below is against monotonic clock */
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    if (pthread_cond_init(&sem->cond, &attr) != 0) {
+        pthread_condattr_destroy(&attr);
+        pthread_mutex_destroy(&sem->mutex);
+        return ERR_MEM;
+    }
+    pthread_condattr_destroy(&attr);
+
+    sem->count = count;
+    sem->valid = 1;
+    return ERR_OK;
+}
+
+void
+sys_sem_signal(sys_sem_t *sem)
+{
+    pthread_mutex_lock(&sem->mutex);
+    sem->count++;
+    pthread_cond_signal(&sem->cond);
+    pthread_mutex_unlock(&sem->mutex);
+}
+
+u32_t
+sys_arch_sem_wait(sys_sem_t *sem, u32_t timeout)
+{
+    u32_t start = sys_now();
+
+    pthread_mutex_lock(&sem->mutex);
+    if (timeout == 0) {
+        while (sem->count == 0) {
+            pthread_cond_wait(&sem->cond, &sem->mutex);
+        }
+    } else {
+        struct timespec ts;
+
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        ts.tv_sec += timeout / 1000;
+        ts.tv_nsec += (long)(timeout % 1000) * 1000000;
+        if (ts.tv_nsec >= 1000000000) {
+            ts.tv_sec++;
+            ts.tv_nsec -= 1000000000;
+        }
+
+        while (sem->count == 0) {
+            if (pthread_cond_timedwait(&sem->cond, &sem->mutex, &ts) != 0) {
+                pthread_mutex_unlock(&sem->mutex);
+                return SYS_ARCH_TIMEOUT;
+            }
+        }
+    }
+    sem->count--;
+    pthread_mutex_unlock(&sem->mutex);
+
+    return sys_now() - start;
+}
+
+void
+sys_sem_free(sys_sem_t *sem)
+{
+    pthread_cond_destroy(&sem->cond);
+    pthread_mutex_destroy(&sem->mutex);
+    sem->valid = 0;
+}
+
+/* Argument passing to POSIX thread entry, whose signature differs */
+struct sys_thread_arg {
+    lwip_thread_fn  thread;
+    void *          arg;
+};
+
+static void *
+sys_thread_entry(void *arg)
+{
+    struct sys_thread_arg thread_arg = *(struct sys_thread_arg *) arg;
+
+    free(arg);
+    thread_arg.thread(thread_arg.arg);
+    return NULL;
+}
+
+sys_thread_t
+sys_thread_new(const char *name, lwip_thread_fn thread, void *arg, int stacksize, int prio)
+{
+    pthread_t pthread;
+    pthread_attr_t attr;
+    struct sys_thread_arg *thread_arg;
+
+    LWIP_UNUSED_ARG(prio);
+
+    thread_arg = (struct sys_thread_arg *) malloc(sizeof(struct sys_thread_arg));
+    LWIP_ASSERT("sys_thread_new: out of memory", thread_arg != NULL);
+    thread_arg->thread = thread;
+    thread_arg->arg = arg;
+
+    pthread_attr_init(&attr);
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+    /* Zero means the host default, which is far larger than on target */
+    if (stacksize > 0) {
+        pthread_attr_setstacksize(&attr, LWIP_MAX((size_t) stacksize, (size_t) PTHREAD_STACK_MIN));
+    }
+    if (pthread_create(&pthread, &attr, sys_thread_entry, thread_arg) != 0) {
+        LWIP_ASSERT("sys_thread_new: pthread_create failed", 0);
+    }
+    pthread_attr_destroy(&attr);
+
+#if defined(__GLIBC__)
+    pthread_setname_np(pthread, name);
+#else
+    LWIP_UNUSED_ARG(name);
+#endif
+
+    return pthread;
+}
@@ -0,0 +1,430 @@
+/*
+ * Copyright (c) 2021, Nuvoton Technology Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. The name of the author may not be used to endorse or promote products
+ *    derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT
+ * SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+ * OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+ * OF SUCH DAMAGE.
+ */
+
+#define _GNU_SOURCE
+
+#include "lwip/apps/snmp_opts.h"
+
+#if LWIP_SNMP && SNMP_USE_NETCONN
+
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include "lwip/ip.h"
+#include "lwip/udp.h"
+#include "snmp_msg.h"
+#include "snmp_core_priv.h"
+#include "lwip/sys.h"
+#include "lwip/prot/iana.h"
+#include "snmp_agent_config.h"
+#include "snmp_posix.h"
+
+/* Maximum UDP payload size */
+#define UDP_PAYLOAD_MAXSIZE         1500
+
+/* Change trap destination IP to SNMP request source
+ *
+ * Same as Mbed transport. See snmp_netconn_mbed.cpp.
+ */
+#ifdef MYSNMPAGENT_TRAP_DST_IP
+#define TRAP_DST_IP_DUMMY               IPADDR4_INIT_BYTES(192, 0, 2, 0)
+#endif
+
+/* SNMP transport context
+ *
+ * Different than Mbed transport, there is no receiver thread dispatching
+ * SNMP requests to worker threads. Instead, every worker thread blocks in
+ * recvfrom() on the same socket with its own receive buffer, and the kernel
+ * hands each request to one of them.
+ */
+struct snmp_posix_ctx {
+    /* Receive SNMP request and send SNMP response */
+    int         sock;
+    /* Send SNMP trap */
+    int         sock_trap;
+    /* Serialize snmp_sendto() among workers and trap sender thread
+     *
+     * This guards udp_payload_buf and ipaddr_trap_dst_redirect, which are
+     * shared by all senders.
+     */
+    sys_mutex_t send_mutex;
+    u8_t        udp_payload_buf[UDP_PAYLOAD_MAXSIZE];
+#ifdef MYSNMPAGENT_TRAP_DST_IP
+    ip_addr_t   ipaddr_trap_dst_redirect;
+#endif
+};
+
+static struct snmp_posix_ctx snmp_posix_ctx;
+
+/* UDP port to receive SNMP requests on */
+static u16_t snmp_posix_port = LWIP_IANA_PORT_SNMP;
+
+void
+snmp_posix_set_port(u16_t port)
+{
+    snmp_posix_port = port;
+}
+
+/* Convert POSIX sockaddr_in to lwIP ip_addr_t, both in network byte order */
+static void
+sockaddr_to_ipaddr(const struct sockaddr_in *sin, ip_addr_t *ipaddr)
+{
+    ip_2_ip4(ipaddr)->addr = sin->sin_addr.s_addr;
+}
+
+/* Convert lwIP ip_addr_t to POSIX sockaddr_in
+ *
+ * Same as above, but reverse.
+ */
+static void
+ipaddr_to_sockaddr(const ip_addr_t *ipaddr, u16_t port, struct sockaddr_in *sin)
+{
+    memset(sin, 0x00, sizeof(*sin));
+    sin->sin_family = AF_INET;
+    sin->sin_addr.s_addr = ip_2_ip4(ipaddr)->addr;
+    sin->sin_port = lwip_htons(port);
+}
+
+/* Resolve trap destination IP, redirecting dummy one to SNMP request source
+ *
+ * Must be called with send_mutex held.
+ */
+static const ip_addr_t *
+snmp_posix_redirect_dst(struct snmp_posix_ctx *ctx, const ip_addr_t *dst)
+{
+#ifdef MYSNMPAGENT_TRAP_DST_IP
+    ip_addr_t trap_dst_ip_dummy = TRAP_DST_IP_DUMMY;
+    if (ip_addr_cmp(dst, &trap_dst_ip_dummy)) {
+        return &ctx->ipaddr_trap_dst_redirect;
+    }
+#else
+    LWIP_UNUSED_ARG(ctx);
+#endif
+    return dst;
+}
+
+/* Pass received SNMP request to SNMP core for handling */
+static void
+snmp_posix_dispatch(struct snmp_posix_ctx *ctx,
+                    const struct sockaddr_in *sin,
+                    u8_t *udp_payload,
+                    u16_t udp_payload_size)
+{
+    struct pbuf *p = NULL;
+
+#if MYSNMPAGENT_RECV_ZEROCOPY
+    /* Reference received SNMP request in place */
+    p = pbuf_alloc_reference(udp_payload, udp_payload_size, PBUF_REF);
+    if (p == NULL) {
+        fprintf(stderr, "pbuf_alloc_reference() for SNMP request failed\n");
+        return;
+    }
+#else
+    p = pbuf_alloc(PBUF_TRANSPORT, udp_payload_size, PBUF_RAM);
+    if (p == NULL) {
+        fprintf(stderr, "pbuf_alloc() for SNMP request failed\n");
+        return;
+    }
+
+    /* Copy received SNMP request to pbuf */
+    err_t err = pbuf_take(p, udp_payload, udp_payload_size);
+    if (err != ERR_OK) {
+        fprintf(stderr, "pbuf_take() for copying SNMP request to pbuf failed: %d\n", err);
+        pbuf_free(p);
+        return;
+    }
+#endif
+
+    ip_addr_t ipaddr;
+    sockaddr_to_ipaddr(sin, &ipaddr);
+
+#ifdef MYSNMPAGENT_TRAP_DST_IP
+    /* Keep SNMP request source as trap destination when it is dummy */
+    sys_mutex_lock(&ctx->send_mutex);
+    ip_addr_copy(ctx->ipaddr_trap_dst_redirect, ipaddr);
+    sys_mutex_unlock(&ctx->send_mutex);
+#endif
+
+    /* Pass to SNMP core for handling */
+    snmp_receive(ctx, p, &ipaddr, lwip_ntohs(sin->sin_port));
+
+    pbuf_free(p);
+}
+
+/** SNMP worker thread, receiving and handling SNMP requests
+ *
+ * recvmmsg() with MSG_WAITFORONE blocks for the first request, then takes
+ * whatever else is queued without blocking, up to SNMP_RECV_BATCH_SIZE.
+ */
+static void
+snmp_posix_thread(void *arg)
+{
+    struct snmp_posix_ctx *ctx = (struct snmp_posix_ctx *) arg;
+    u8_t udp_recv_buf[SNMP_RECV_BATCH_SIZE][UDP_PAYLOAD_MAXSIZE];
+    struct sockaddr_in sin[SNMP_RECV_BATCH_SIZE];
+    struct iovec iov[SNMP_RECV_BATCH_SIZE];
+    struct mmsghdr msgs[SNMP_RECV_BATCH_SIZE];
+    int i;
+
+    do {
+        memset(msgs, 0x00, sizeof(msgs));
+        for (i = 0; i < SNMP_RECV_BATCH_SIZE; i++) {
+            iov[i].iov_base = udp_recv_buf[i];
+            iov[i].iov_len = UDP_PAYLOAD_MAXSIZE;
+            msgs[i].msg_hdr.msg_iov = &iov[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+            msgs[i].msg_hdr.msg_name = &sin[i];
+            msgs[i].msg_hdr.msg_namelen = sizeof(sin[i]);
+        }
+
+        int batch_size = recvmmsg(ctx->sock, msgs, SNMP_RECV_BATCH_SIZE, MSG_WAITFORONE, NULL);
+        if (batch_size <= 0) {
+            if (batch_size < 0 && errno != EINTR) {
+                fprintf(stderr, "Receive SNMP request over UDP failed: %d\n", errno);
+            }
+            continue;
+        }
+
+#if SNMP_RECV_BATCH_SIZE > 1
+        SNMP_STATS_INC(inbatchsizes[batch_size - 1]);
+#endif
+
+        /* Handle the whole batch. Responses go out as each request completes. */
+        for (i = 0; i < batch_size; i++) {
+            if (msgs[i].msg_len == 0) {
+                continue;
+            }
+
+            LWIP_DEBUGF(SNMP_DEBUG, ("Receive SNMP request (%u) over UDP from: %s:%d\n",
+                                     msgs[i].msg_len, ip4addr_ntoa((const ip4_addr_t *) &sin[i].sin_addr),
+                                     lwip_ntohs(sin[i].sin_port)));
+
+#if SNMP_RATE_LIMIT_SOURCES > 0
+            /* Drop request over rate limit before any parsing */
+            ip_addr_t ipaddr;
+            sockaddr_to_ipaddr(&sin[i], &ipaddr);
+            if (!snmp_rate_limit_admit(&ipaddr)) {
+                continue;
+            }
+#endif
+
+            snmp_posix_dispatch(ctx, &sin[i], udp_recv_buf[i], (u16_t) msgs[i].msg_len);
+        }
+    } while (1);
+}
+
+err_t
+snmp_sendto(void *handle, struct pbuf *p, const ip_addr_t *dst, u16_t port)
+{
+    struct snmp_posix_ctx *ctx = (struct snmp_posix_ctx *) handle;
+    if (ctx == NULL) {
+        fprintf(stderr, "snmp_sendto(): Invalid handle\n");
+        return ERR_ARG;
+    }
+
+    err_t err = ERR_OK;
+
+    sys_mutex_lock(&ctx->send_mutex);
+
+    u16_t udp_payload_size = p->tot_len;
+    void *udp_payload = pbuf_get_contiguous(p,
+                                            ctx->udp_payload_buf,
+                                            UDP_PAYLOAD_MAXSIZE,
+                                            udp_payload_size,
+                                            0);
+    if (udp_payload == NULL) {
+        fprintf(stderr, "snmp_sendto(): pbuf_get_contiguous() returns null\n");
+        err = ERR_BUF;
+        goto cleanup;
+    }
+
+    dst = snmp_posix_redirect_dst(ctx, dst);
+
+    struct sockaddr_in sin;
+    ipaddr_to_sockaddr(dst, port, &sin);
+
+    /* Send response or trap? */
+    int send_trap = (port == LWIP_IANA_PORT_SNMP_TRAP);
+
+    LWIP_DEBUGF(SNMP_DEBUG, ("Send SNMP %s (%d) over UDP to: %s:%d\n",
+                             send_trap ? "trap" : "response",
+                             udp_payload_size,
+                             ipaddr_ntoa(dst),
+                             port));
+
+    ssize_t rc = sendto(send_trap ? ctx->sock_trap : ctx->sock,
+                        udp_payload,
+                        udp_payload_size,
+                        0,
+                        (const struct sockaddr *) &sin,
+                        sizeof(sin));
+    if (rc < 0) {
+        fprintf(stderr, "Send SNMP %s over UDP failed: %d\n",
+                send_trap ? "trap" : "response",
+                errno);
+        err = ERR_IF;
+    } else if (rc != udp_payload_size) {
+        fprintf(stderr, "Send SNMP %s over UDP incomplete: Expected %d but %d\n",
+                send_trap ? "trap" : "response",
+                udp_payload_size,
+                (int) rc);
+        err = ERR_IF;
+    }
+
+cleanup:
+
+    sys_mutex_unlock(&ctx->send_mutex);
+
+    return err;
+}
+
+u8_t
+snmp_get_local_ip_for_dst(void *handle, const ip_addr_t *dst, ip_addr_t *result)
+{
+    struct snmp_posix_ctx *ctx = (struct snmp_posix_ctx *) handle;
+    if (ctx == NULL) {
+        fprintf(stderr, "snmp_get_local_ip_for_dst: Invalid handle\n");
+        return 0;
+    }
+
+    /* Sockets above are IPv4 only */
+    if (IP_IS_V6(dst)) {
+        return SNMP_LOCAL_IP_NO_VERSION;
+    }
+
+    struct sockaddr_in sin;
+    sys_mutex_lock(&ctx->send_mutex);
+    ipaddr_to_sockaddr(snmp_posix_redirect_dst(ctx, dst), LWIP_IANA_PORT_SNMP_TRAP, &sin);
+    sys_mutex_unlock(&ctx->send_mutex);
+
+    /* Let the kernel route to the destination. Connecting a UDP socket sends
+     * nothing, but binds it to the local IP address of the outgoing interface. */
+    int sock = socket(AF_INET, SOCK_DGRAM, 0);
+    if (sock < 0) {
+        fprintf(stderr, "snmp_get_local_ip_for_dst: Open UDP socket failed: %d\n", errno);
+        return 0;
+    }
+
+    u8_t found = 0;
+    struct sockaddr_in local;
+    socklen_t local_len = sizeof(local);
+    if (connect(sock, (const struct sockaddr *) &sin, sizeof(sin)) == 0 &&
+        getsockname(sock, (struct sockaddr *) &local, &local_len) == 0) {
+        sockaddr_to_ipaddr(&local, result);
+        found = 1;
+    } else {
+        fprintf(stderr, "snmp_get_local_ip_for_dst: No route to destination: %d\n", errno);
+    }
+
+    close(sock);
+    return found;
+}
+
+u16_t
+snmp_get_max_payload_for_dst(void *handle, const ip_addr_t *dst)
+{
+    struct snmp_posix_ctx *ctx = (struct snmp_posix_ctx *) handle;
+    if (ctx == NULL) {
+        fprintf(stderr, "snmp_get_max_payload_for_dst: Invalid handle\n");
+        return 0;
+    }
+
+    /* The kernel fragments datagrams unless path MTU discovery sets DF on
+     * the socket. Otherwise the response is only limited by the send buffer
+     * of snmp_sendto(). */
+    int pmtudisc = IP_PMTUDISC_DONT;
+    socklen_t optlen = sizeof(pmtudisc);
+    if (getsockopt(ctx->sock, IPPROTO_IP, IP_MTU_DISCOVER, &pmtudisc, &optlen) != 0 ||
+        (pmtudisc != IP_PMTUDISC_DO && pmtudisc != IP_PMTUDISC_PROBE)) {
+        return UDP_PAYLOAD_MAXSIZE;
+    }
+
+    struct sockaddr_in sin;
+    ipaddr_to_sockaddr(dst, LWIP_IANA_PORT_SNMP_TRAP, &sin);
+
+    int sock = socket(AF_INET, SOCK_DGRAM, 0);
+    if (sock < 0) {
+        fprintf(stderr, "snmp_get_max_payload_for_dst: Open UDP socket failed: %d\n", errno);
+        return UDP_PAYLOAD_MAXSIZE;
+    }
+
+    /* Path MTU as known to the kernel for the connected destination */
+    u16_t max_payload = UDP_PAYLOAD_MAXSIZE;
+    int mtu;
+    optlen = sizeof(mtu);
+    if (connect(sock, (const struct sockaddr *) &sin, sizeof(sin)) == 0 &&
+        getsockopt(sock, IPPROTO_IP, IP_MTU, &mtu, &optlen) == 0 &&
+        mtu > IP_HLEN + UDP_HLEN && mtu - IP_HLEN - UDP_HLEN < max_payload) {
+        max_payload = (u16_t) (mtu - IP_HLEN - UDP_HLEN);
+    }
+
+    close(sock);
+    return max_payload;
+}
+
+/**
+ * Starts SNMP Agent.
+ */
+void
+snmp_init(void)
+{
+  struct snmp_posix_ctx *ctx = &snmp_posix_ctx;
+  struct sockaddr_in sin;
+  int i;
+
+  LWIP_ASSERT_CORE_LOCKED();
+#if SNMP_WORKER_THREADS > 1
+  snmp_msg_init();
+#endif
+#if SNMP_TRAP_QUEUE_SIZE > 0
+  snmp_trap_queue_init();
+#endif
+
+  ctx->sock = socket(AF_INET, SOCK_DGRAM, 0);
+  LWIP_ERROR("snmp_posix: open UDP socket failed", (ctx->sock >= 0), return;);
+
+  /* Separate socket for sending traps, same as Mbed transport */
+  ctx->sock_trap = socket(AF_INET, SOCK_DGRAM, 0);
+  LWIP_ERROR("snmp_posix: open UDP socket (for sending traps) failed", (ctx->sock_trap >= 0), return;);
+
+  /* Bind to SNMP port with default IP address */
+  ipaddr_to_sockaddr(IP4_ADDR_ANY, snmp_posix_port, &sin);
+  LWIP_ERROR("snmp_posix: bind to SNMP port failed",
+             (bind(ctx->sock, (const struct sockaddr *) &sin, sizeof(sin)) == 0), return;);
+
+  LWIP_ERROR("snmp_posix: create send mutex failed", (sys_mutex_new(&ctx->send_mutex) == ERR_OK), return;);
+
+  snmp_traps_handle = ctx;
+
+  for (i = 0; i < SNMP_WORKER_THREADS; i++) {
+    sys_thread_new("snmp_worker", snmp_posix_thread, ctx, SNMP_STACK_SIZE, SNMP_THREAD_PRIO);
+  }
+}
+
+#endif /* LWIP_SNMP && SNMP_USE_NETCONN */
@@ -196,8 +196,23 @@
 #if SNMP_MAX_OBJ_ID_LEN > 255
 #error "SNMP_MAX_OBJ_ID_LEN must fit into an u8_t"
 #endif
+#if (SNMP_TABLE_NEXT_CELLS > 255) || (SNMP_TABLE_NEXT_CELLS_ROW_OID_LEN > 255)
+#error "SNMP_TABLE_NEXT_CELLS and SNMP_TABLE_NEXT_CELLS_ROW_OID_LEN must fit into an u8_t"
+#endif
 
+#if SNMP_WORKER_THREADS > 1
+struct snmp_statistics snmp_stats_shards[SNMP_WORKER_THREADS + 1];
+static u8_t snmp_stats_shard_in_use[SNMP_WORKER_THREADS];
+#else
 struct snmp_statistics snmp_stats;
+#endif
+#if SNMP_PROFILE
+u32_t snmp_profile[SNMP_PROFILE_PDUS][SNMP_PROFILE_PHASES][SNMP_PROFILE_BUCKETS];
+#endif
+#if SNMP_WALK_CACHE_SIZE > 0
+/* starts at 1, so a zeroed snmp_next_hint is never valid */
+u32_t snmp_next_hint_generation = 1;
+#endif
 static const struct snmp_obj_id  snmp_device_enterprise_oid_default = {SNMP_DEVICE_ENTERPRISE_OID_LEN, SNMP_DEVICE_ENTERPRISE_OID};
 static const struct snmp_obj_id *snmp_device_enterprise_oid         = &snmp_device_enterprise_oid_default;
 
@@ -221,6 +236,250 @@ static u8_t snmp_num_mibs                          = 0;
 
 /* List of known mibs */
 static struct snmp_mib const *const *snmp_mibs = default_mibs;
+#if SNMP_SORTED_TREE_NODES
+/* set if the subnodes of all tree nodes of snmp_mibs are sorted, see snmp_set_mibs() */
+static u8_t snmp_mibs_sorted;
+
+/**
+ * Checks that the subnodes of every tree node below node are in ascending OID order,
+ * without duplicates.
+ */
+static u8_t
+snmp_tree_node_is_sorted(const struct snmp_node *node)
+{
+  const struct snmp_tree_node *tree_node;
+  u16_t i;
+
+  if (node->node_type != SNMP_NODE_TREE) {
+    return 1;
+  }
+
+  tree_node = (const struct snmp_tree_node *)(const void *)node;
+  for (i = 0; i < tree_node->subnode_count; i++) {
+    if ((i > 0) && (tree_node->subnodes[i - 1]->oid >= tree_node->subnodes[i]->oid)) {
+      LWIP_DEBUGF(SNMP_DEBUG, ("snmp_set_mibs(): subnodes of tree node %"U32_F" are not sorted\n", node->oid));
+      return 0;
+    }
+    if (!snmp_tree_node_is_sorted(tree_node->subnodes[i])) {
+      return 0;
+    }
+  }
+
+  return 1;
+}
+#endif
+
+#if SNMP_MIB_REGISTRY_SIZE > 0
+#if SNMP_MIB_REGISTRY_SIZE > 254
+#error SNMP_MIB_REGISTRY_SIZE must fit into u8_t
+#endif
+#define SNMP_MIB_REGISTRY_NO_PARENT 0xFF
+
+/* MIBs ascending by base OID, for binary search */
+struct snmp_mib_registry {
+  u8_t num_mibs;
+  const struct snmp_mib *mibs[SNMP_MIB_REGISTRY_SIZE];
+  /* index of the MIB with the longest base OID being a prefix of the base OID of mibs[i], SNMP_MIB_REGISTRY_NO_PARENT if none */
+  u8_t parent[SNMP_MIB_REGISTRY_SIZE];
+};
+
+/* a registry is never changed while published, changes are built in the other one and swapped in */
+static struct snmp_mib_registry snmp_mib_registry_storage[2];
+/* index of the storage the next change is built in */
+static u8_t snmp_mib_registry_spare;
+/* registry requests start on, NULL if snmp_mibs are scanned (not set by snmp_set_mibs() or too many) */
+static const struct snmp_mib_registry *volatile snmp_mib_registry;
+/* registry pinned by the request of each reader slot, see snmp_mib_registry_acquire() */
+static const struct snmp_mib_registry *volatile snmp_mib_registry_readers[SNMP_MIB_REGISTRY_READERS];
+#if SNMP_WORKER_THREADS > 1
+/* requests on SNMP_MIB_REGISTRY_SHARED_READER pinning each storage, protect with SYS_ARCH_PROTECT */
+static u8_t snmp_mib_registry_shared_readers[2];
+#endif
+
+static u8_t
+snmp_mib_base_oid_is_prefix(const struct snmp_mib *mib, const u32_t *oid, u8_t oid_len)
+{
+  return (oid_len >= mib->base_oid_len) &&
+         (memcmp(mib->base_oid, oid, mib->base_oid_len * sizeof(u32_t)) == 0);
+}
+
+/* index of the first MIB with a base OID > oid, registry->num_mibs if none */
+static u8_t
+snmp_mib_registry_upper_bound(const struct snmp_mib_registry *registry, const u32_t *oid, u8_t oid_len)
+{
+  u8_t lower = 0;
+  u8_t upper = registry->num_mibs;
+
+  while (lower < upper) {
+    u8_t middle = (u8_t)(lower + ((upper - lower) >> 1));
+    if (snmp_oid_compare(registry->mibs[middle]->base_oid, registry->mibs[middle]->base_oid_len, oid, oid_len) <= 0) {
+      lower = (u8_t)(middle + 1);
+    } else {
+      upper = middle;
+    }
+  }
+
+  return lower;
+}
+
+/* returns 0 if there are too many MIBs */
+static u8_t
+snmp_mib_registry_build(struct snmp_mib_registry *registry, const struct snmp_mib **mibs, u8_t num_mibs)
+{
+  u8_t i, j;
+
+  if (num_mibs > SNMP_MIB_REGISTRY_SIZE) {
+    LWIP_DEBUGF(SNMP_DEBUG, ("snmp_set_mibs(): more than SNMP_MIB_REGISTRY_SIZE MIBs, scanning them\n"));
+    return 0;
+  }
+
+  /* insertion sort, a later MIB with the same base OID as an earlier one is never selected */
+  registry->num_mibs = 0;
+  for (i = 0; i < num_mibs; i++) {
+    const struct snmp_mib *mib = mibs[i];
+    s8_t cmp = 1;
+
+    LWIP_ASSERT("MIB array not initialized correctly", (mib != NULL));
+    LWIP_ASSERT("MIB array not initialized correctly - base OID is NULL", (mib->base_oid != NULL));
+
+    j = registry->num_mibs;
+    while ((j > 0) &&
+           ((cmp = snmp_oid_compare(registry->mibs[j - 1]->base_oid, registry->mibs[j - 1]->base_oid_len, mib->base_oid, mib->base_oid_len)) > 0)) {
+      j--;
+    }
+    if ((j > 0) && (cmp == 0)) {
+      continue;
+    }
+
+    memmove(&registry->mibs[j + 1], &registry->mibs[j], (registry->num_mibs - j) * sizeof(registry->mibs[0]));
+    registry->mibs[j] = mib;
+    registry->num_mibs++;
+  }
+
+  /* MIBs between a MIB and its parent are below the parent as well, so the parent is on the chain of the previous one */
+  for (i = 0; i < registry->num_mibs; i++) {
+    j = (i > 0) ? (u8_t)(i - 1) : SNMP_MIB_REGISTRY_NO_PARENT;
+    while ((j != SNMP_MIB_REGISTRY_NO_PARENT) &&
+           !snmp_mib_base_oid_is_prefix(registry->mibs[j], registry->mibs[i]->base_oid, registry->mibs[i]->base_oid_len)) {
+      j = registry->parent[j];
+    }
+    registry->parent[i] = j;
+  }
+
+  return 1;
+}
+
+/**
+ * Pins the current registry for the request of a reader slot until snmp_mib_registry_release().
+ * Reader slots SNMP_MIB_REGISTRY_SHARED_READER excepted, a slot is used by one request at a time
+ * and pinning it takes no lock: the slot is set, then checked against the registry published
+ * in the meantime.
+ */
+const struct snmp_mib_registry *
+snmp_mib_registry_acquire(u8_t reader)
+{
+  const struct snmp_mib_registry *registry;
+
+#if SNMP_WORKER_THREADS > 1
+  if (reader == SNMP_MIB_REGISTRY_SHARED_READER) {
+    SYS_ARCH_DECL_PROTECT(old_level);
+
+    SYS_ARCH_PROTECT(old_level);
+    registry = snmp_mib_registry;
+    if (registry != NULL) {
+      snmp_mib_registry_shared_readers[registry - snmp_mib_registry_storage]++;
+    }
+    SYS_ARCH_UNPROTECT(old_level);
+    return registry;
+  }
+#endif
+
+  do {
+    registry = snmp_mib_registry;
+    snmp_mib_registry_readers[reader] = registry;
+    SNMP_MEMORY_BARRIER();
+  } while (registry != snmp_mib_registry);
+
+  return registry;
+}
+
+void
+snmp_mib_registry_release(u8_t reader, const struct snmp_mib_registry *registry)
+{
+#if SNMP_WORKER_THREADS > 1
+  if (reader == SNMP_MIB_REGISTRY_SHARED_READER) {
+    SYS_ARCH_DECL_PROTECT(old_level);
+
+    if (registry != NULL) {
+      SYS_ARCH_PROTECT(old_level);
+      snmp_mib_registry_shared_readers[registry - snmp_mib_registry_storage]--;
+      SYS_ARCH_UNPROTECT(old_level);
+    }
+    return;
+  }
+#endif
+
+  LWIP_UNUSED_ARG(registry);
+  SNMP_MEMORY_BARRIER();
+  snmp_mib_registry_readers[reader] = NULL;
+}
+
+static u8_t
+snmp_mib_registry_in_use(const struct snmp_mib_registry *registry)
+{
+  u8_t in_use = 0;
+  u8_t i;
+
+  for (i = 0; i < SNMP_MIB_REGISTRY_READERS; i++) {
+    if (snmp_mib_registry_readers[i] == registry) {
+      in_use = 1;
+    }
+  }
+#if SNMP_WORKER_THREADS > 1
+  {
+    SYS_ARCH_DECL_PROTECT(old_level);
+
+    SYS_ARCH_PROTECT(old_level);
+    if (snmp_mib_registry_shared_readers[registry - snmp_mib_registry_storage] != 0) {
+      in_use = 1;
+    }
+    SYS_ARCH_UNPROTECT(old_level);
+  }
+#endif
+
+  return in_use;
+}
+
+/**
+ * Builds the spare registry from mibs and publishes it, requests started before keep the
+ * registry they pinned. Publishes NULL (scanning snmp_mibs) if there are too many MIBs.
+ * Returns 0 in that case.
+ */
+static u8_t
+snmp_mib_registry_publish(const struct snmp_mib **mibs, u8_t num_mibs)
+{
+  struct snmp_mib_registry *spare = &snmp_mib_registry_storage[snmp_mib_registry_spare];
+
+  /* unpublished since the previous change, wait for the requests that pinned it before */
+  SNMP_MEMORY_BARRIER();
+  while (snmp_mib_registry_in_use(spare)) {
+#if !NO_SYS
+    sys_msleep(1);
+#endif
+  }
+
+  if (!snmp_mib_registry_build(spare, mibs, num_mibs)) {
+    snmp_mib_registry = NULL;
+    return 0;
+  }
+
+  SNMP_MEMORY_BARRIER();
+  snmp_mib_registry = spare;
+  snmp_mib_registry_spare ^= 1;
+
+  return 1;
+}
+#endif /* SNMP_MIB_REGISTRY_SIZE > 0 */
 
 /**
  * @ingroup snmp_core
@@ -235,13 +494,240 @@ static struct snmp_mib const *const *snmp_mibs = default_mibs;
 void
 snmp_set_mibs(const struct snmp_mib **mibs, u8_t num_mibs)
 {
+#if SNMP_SORTED_TREE_NODES
+  u8_t sorted = 1;
+  u8_t i;
+#endif
+
   LWIP_ASSERT_CORE_LOCKED();
   LWIP_ASSERT("mibs pointer must be != NULL", (mibs != NULL));
   LWIP_ASSERT("num_mibs pointer must be != 0", (num_mibs != 0));
+#if SNMP_SORTED_TREE_NODES
+  for (i = 0; i < num_mibs; i++) {
+    sorted &= snmp_tree_node_is_sorted(mibs[i]->root_node);
+  }
+  if (!sorted) {
+    /* no binary search in the new MIBs from now on */
+    snmp_mibs_sorted = 0;
+  }
+#endif
   snmp_mibs     = mibs;
   snmp_num_mibs = num_mibs;
+#if SNMP_MIB_REGISTRY_SIZE > 0
+  snmp_mib_registry_publish(mibs, num_mibs);
+#endif
+#if SNMP_SORTED_TREE_NODES
+  snmp_mibs_sorted = sorted;
+#endif
+#if SNMP_WALK_CACHE_SIZE > 0
+  snmp_next_hint_invalidate();
+#endif
+#if SNMP_VALUE_CACHE_SIZE > 0
+  snmp_value_cache_flush();
+#endif
+}
+
+#if SNMP_MIB_REGISTRY_SIZE > 0
+/* copies the MIBs in use to mibs, returns their number or 0xFF if there are too many */
+static u8_t
+snmp_mib_registry_copy(const struct snmp_mib **mibs)
+{
+  const struct snmp_mib_registry *registry = snmp_mib_registry;
+  u8_t i;
+
+  if (registry != NULL) {
+    MEMCPY(mibs, registry->mibs, registry->num_mibs * sizeof(mibs[0]));
+    return registry->num_mibs;
+  }
+  if (snmp_num_mibs > SNMP_MIB_REGISTRY_SIZE) {
+    return 0xFF;
+  }
+  for (i = 0; i < snmp_num_mibs; i++) {
+    mibs[i] = snmp_mibs[i];
+  }
+  return snmp_num_mibs;
+}
+
+/**
+ * @ingroup snmp_core
+ * Adds a MIB to the MIBs in use, e.g. for a peripheral detected at runtime.
+ * The MIBs are published at once, requests already being processed finish on the previous ones.
+ * Waits until no request uses the MIBs before the previous change, so must not be called from
+ * a thread those requests wait for (e.g. tcpip thread if snmp_threadsync is used).
+ * Calls must not overlap with each other or with snmp_set_mibs().
+ * @param mib MIB to add, must stay valid until removed
+ * @return ERR_OK, ERR_ARG if a MIB with the same base OID is in use,
+ *         ERR_MEM if there would be more than SNMP_MIB_REGISTRY_SIZE MIBs
+ */
+err_t
+snmp_register_mib(const struct snmp_mib *mib)
+{
+  const struct snmp_mib *mibs[SNMP_MIB_REGISTRY_SIZE + 1];
+  u8_t num_mibs;
+  u8_t i;
+
+  LWIP_ASSERT("mib pointer must be != NULL", (mib != NULL));
+  LWIP_ASSERT("MIB not initialized correctly - base OID is NULL", (mib->base_oid != NULL));
+
+  num_mibs = snmp_mib_registry_copy(mibs);
+  if (num_mibs >= SNMP_MIB_REGISTRY_SIZE) {
+    return ERR_MEM;
+  }
+  for (i = 0; i < num_mibs; i++) {
+    if (snmp_oid_equal(mibs[i]->base_oid, mibs[i]->base_oid_len, mib->base_oid, mib->base_oid_len)) {
+      return ERR_ARG;
+    }
+  }
+  mibs[num_mibs++] = mib;
+
+#if SNMP_SORTED_TREE_NODES
+  if (!snmp_tree_node_is_sorted(mib->root_node)) {
+    /* no binary search in the new MIB from now on */
+    snmp_mibs_sorted = 0;
+  }
+#endif
+  snmp_mib_registry_publish(mibs, num_mibs);
+#if SNMP_WALK_CACHE_SIZE > 0
+  snmp_next_hint_invalidate();
+#endif
+#if SNMP_VALUE_CACHE_SIZE > 0
+  snmp_value_cache_flush();
+#endif
+
+  return ERR_OK;
+}
+
+/**
+ * @ingroup snmp_core
+ * Removes a MIB added by snmp_register_mib() or snmp_set_mibs() from the MIBs in use.
+ * Waits until no request already being processed uses it, so the MIB may go away on return.
+ * See snmp_register_mib() for the threads this must not be called from.
+ * @param mib MIB to remove
+ * @return ERR_OK, ERR_ARG if the MIB is not in use,
+ *         ERR_MEM if there are more than SNMP_MIB_REGISTRY_SIZE MIBs
+ */
+err_t
+snmp_unregister_mib(const struct snmp_mib *mib)
+{
+  const struct snmp_mib *mibs[SNMP_MIB_REGISTRY_SIZE];
+  const struct snmp_mib_registry *previous = snmp_mib_registry;
+  u8_t num_mibs;
+  u8_t i;
+
+  LWIP_ASSERT("mib pointer must be != NULL", (mib != NULL));
+
+  num_mibs = snmp_mib_registry_copy(mibs);
+  if (num_mibs > SNMP_MIB_REGISTRY_SIZE) {
+    return ERR_MEM;
+  }
+  for (i = 0; i < num_mibs; i++) {
+    if (mibs[i] == mib) {
+      break;
+    }
+  }
+  if (i == num_mibs) {
+    return ERR_ARG;
+  }
+  num_mibs--;
+  memmove(&mibs[i], &mibs[i + 1], (num_mibs - i) * sizeof(mibs[0]));
+
+  snmp_mib_registry_publish(mibs, num_mibs);
+#if SNMP_WALK_CACHE_SIZE > 0
+  /* requests started from now on pin the new registry and drop hints into mib */
+  snmp_next_hint_invalidate();
+#endif
+  if (previous != NULL) {
+    /* wait for the requests that pinned mib, their hints are stale already */
+    SNMP_MEMORY_BARRIER();
+    while (snmp_mib_registry_in_use(previous)) {
+#if !NO_SYS
+      sys_msleep(1);
+#endif
+    }
+  }
+#if SNMP_VALUE_CACHE_SIZE > 0
+  /* no request can cache values of mib any more */
+  snmp_value_cache_flush();
+#endif
+
+  return ERR_OK;
+}
+#endif /* SNMP_MIB_REGISTRY_SIZE > 0 */
+
+#if SNMP_WALK_CACHE_SIZE > 0
+/**
+ * Invalidates all snmp_next_hint's, because the MIB tree or the data behind it changed.
+ */
+void
+snmp_next_hint_invalidate(void)
+{
+  SYS_ARCH_DECL_PROTECT(old_level);
+
+  SYS_ARCH_PROTECT(old_level);
+  snmp_next_hint_generation++;
+  if (snmp_next_hint_generation == 0) {
+    /* keep zeroed hints invalid */
+    snmp_next_hint_generation = 1;
+  }
+  SYS_ARCH_UNPROTECT(old_level);
+}
+#endif
+
+#if SNMP_WORKER_THREADS > 1
+/**
+ * Claims a statistics shard for the request being processed by the calling worker.
+ * Returns NULL if all shards are in use, updates then go to the shared shard.
+ */
+struct snmp_statistics *
+snmp_stats_shard_alloc(void)
+{
+  struct snmp_statistics *shard = NULL;
+  u8_t i;
+  SYS_ARCH_DECL_PROTECT(old_level);
+
+  SYS_ARCH_PROTECT(old_level);
+  for (i = 0; i < SNMP_WORKER_THREADS; i++) {
+    if (!snmp_stats_shard_in_use[i]) {
+      snmp_stats_shard_in_use[i] = 1;
+      shard = &snmp_stats_shards[i];
+      break;
+    }
+  }
+  SYS_ARCH_UNPROTECT(old_level);
+
+  return shard;
+}
+
+void
+snmp_stats_shard_free(struct snmp_statistics *shard)
+{
+  SYS_ARCH_DECL_PROTECT(old_level);
+
+  SYS_ARCH_PROTECT(old_level);
+  snmp_stats_shard_in_use[shard - snmp_stats_shards] = 0;
+  SYS_ARCH_UNPROTECT(old_level);
 }
 
+/**
+ * @ingroup snmp_core
+ * Sums one counter over all statistics shards, use SNMP_STATS_GET() to read a counter.
+ * @param shard0_counter the counter in snmp_stats_shards[0]
+ */
+u32_t
+snmp_stats_sum(const u32_t *shard0_counter)
+{
+  size_t offset = (size_t)((const u8_t *)shard0_counter - (const u8_t *)&snmp_stats_shards[0]);
+  u32_t sum = 0;
+  u8_t i;
+
+  for (i = 0; i < LWIP_ARRAYSIZE(snmp_stats_shards); i++) {
+    sum += *(const u32_t *)((const u8_t *)&snmp_stats_shards[i] + offset);
+  }
+
+  return sum;
+}
+#endif
+
 /**
  * @ingroup snmp_core
  * 'device enterprise oid' is used for 'device OID' field in trap PDU's (for identification of generating device)
@@ -576,6 +1062,7 @@ snmp_oid_prefix(struct snmp_obj_id *target, const u32_t *oid, u8_t oid_len)
 
     /* paste oid at the beginning */
     MEMCPY(target->id, oid, oid_len * sizeof(u32_t));
+    target->len = (u8_t)(target->len + oid_len);
   }
 }
 
@@ -678,7 +1165,7 @@ netif_to_num(const struct netif *netif)
 }
 
 static const struct snmp_mib *
-snmp_get_mib_from_oid(const u32_t *oid, u8_t oid_len)
+snmp_get_mib_from_oid(const struct snmp_mib_registry *registry, const u32_t *oid, u8_t oid_len)
 {
   const u32_t *list_oid;
   const u32_t *searched_oid;
@@ -693,6 +1180,21 @@ snmp_get_mib_from_oid(const u32_t *oid, u8_t oid_len)
     return NULL;
   }
 
+#if SNMP_MIB_REGISTRY_SIZE > 0
+  if (registry != NULL) {
+    /* the longest prefix is the last MIB not after oid, or one of its parents */
+    i = snmp_mib_registry_upper_bound(registry, oid, oid_len);
+    i = (i > 0) ? (u8_t)(i - 1) : SNMP_MIB_REGISTRY_NO_PARENT;
+    while ((i != SNMP_MIB_REGISTRY_NO_PARENT) && !snmp_mib_base_oid_is_prefix(registry->mibs[i], oid, oid_len)) {
+      i = registry->parent[i];
+    }
+
+    return (i != SNMP_MIB_REGISTRY_NO_PARENT) ? registry->mibs[i] : NULL;
+  }
+#else
+  LWIP_UNUSED_ARG(registry);
+#endif
+
   for (i = 0; i < snmp_num_mibs; i++) {
     LWIP_ASSERT("MIB array not initialized correctly", (snmp_mibs[i] != NULL));
     LWIP_ASSERT("MIB array not initialized correctly - base OID is NULL", (snmp_mibs[i]->base_oid != NULL));
@@ -723,7 +1225,7 @@ snmp_get_mib_from_oid(const u32_t *oid, u8_t oid_len)
 }
 
 static const struct snmp_mib *
-snmp_get_next_mib(const u32_t *oid, u8_t oid_len)
+snmp_get_next_mib(const struct snmp_mib_registry *registry, const u32_t *oid, u8_t oid_len)
 {
   u8_t i;
   const struct snmp_mib *next_mib = NULL;
@@ -734,6 +1236,15 @@ snmp_get_next_mib(const u32_t *oid, u8_t oid_len)
     return NULL;
   }
 
+#if SNMP_MIB_REGISTRY_SIZE > 0
+  if (registry != NULL) {
+    i = snmp_mib_registry_upper_bound(registry, oid, oid_len);
+    return (i < registry->num_mibs) ? registry->mibs[i] : NULL;
+  }
+#else
+  LWIP_UNUSED_ARG(registry);
+#endif
+
   for (i = 0; i < snmp_num_mibs; i++) {
     if (snmp_mibs[i]->base_oid != NULL) {
       /* check if mib is located behind starting point */
@@ -751,9 +1262,9 @@ snmp_get_next_mib(const u32_t *oid, u8_t oid_len)
 }
 
 static const struct snmp_mib *
-snmp_get_mib_between(const u32_t *oid1, u8_t oid1_len, const u32_t *oid2, u8_t oid2_len)
+snmp_get_mib_between(const struct snmp_mib_registry *registry, const u32_t *oid1, u8_t oid1_len, const u32_t *oid2, u8_t oid2_len)
 {
-  const struct snmp_mib *next_mib = snmp_get_next_mib(oid1, oid1_len);
+  const struct snmp_mib *next_mib = snmp_get_next_mib(registry, oid1, oid1_len);
 
   LWIP_ASSERT("'oid2' param must not be NULL!", (oid2 != NULL));
   LWIP_ASSERT("'oid2_len' param must be greater than 0!", (oid2_len > 0));
@@ -768,13 +1279,13 @@ snmp_get_mib_between(const u32_t *oid1, u8_t oid1_len, const u32_t *oid2, u8_t o
 }
 
 u8_t
-snmp_get_node_instance_from_oid(const u32_t *oid, u8_t oid_len, struct snmp_node_instance *node_instance)
+snmp_get_node_instance_from_oid(const struct snmp_mib_registry *registry, const u32_t *oid, u8_t oid_len, struct snmp_node_instance *node_instance)
 {
   u8_t result = SNMP_ERR_NOSUCHOBJECT;
   const struct snmp_mib *mib;
   const struct snmp_node *mn = NULL;
 
-  mib = snmp_get_mib_from_oid(oid, oid_len);
+  mib = snmp_get_mib_from_oid(registry, oid, oid_len);
   if (mib != NULL) {
     u8_t oid_instance_len;
 
@@ -808,18 +1319,35 @@ snmp_get_node_instance_from_oid(const u32_t *oid, u8_t oid_len, struct snmp_node
 }
 
 u8_t
-snmp_get_next_node_instance_from_oid(const u32_t *oid, u8_t oid_len, snmp_validate_node_instance_method validate_node_instance_method, void *validate_node_instance_arg, struct snmp_obj_id *node_oid, struct snmp_node_instance *node_instance)
+snmp_get_next_node_instance_from_oid(const struct snmp_mib_registry *registry, const u32_t *oid, u8_t oid_len, snmp_validate_node_instance_method validate_node_instance_method, void *validate_node_instance_arg, struct snmp_obj_id *node_oid, struct snmp_node_instance *node_instance, struct snmp_next_hint *hint)
 {
   const struct snmp_mib      *mib;
   const struct snmp_node *mn = NULL;
   const u32_t *start_oid     = NULL;
   u8_t         start_oid_len = 0;
+  const struct snmp_node *hint_node = NULL;
+
+#if SNMP_WALK_CACHE_SIZE > 0
+  if (hint != NULL) {
+    if ((hint->generation == hint->request_generation) && snmp_oid_equal(oid, oid_len, hint->oid.id, hint->oid.len)) {
+      /* passed OID was returned last time, continue at the same node */
+      hint_node = hint->node;
+    }
+    hint->hit = (hint_node != NULL);
+  }
+#else
+  LWIP_UNUSED_ARG(hint);
+#endif
 
   /* resolve target MIB from passed OID */
-  mib = snmp_get_mib_from_oid(oid, oid_len);
+  if (hint_node != NULL) {
+    mib = hint->mib;
+  } else {
+    mib = snmp_get_mib_from_oid(registry, oid, oid_len);
+  }
   if (mib == NULL) {
     /* passed OID does not reference any known MIB, start at the next closest MIB */
-    mib = snmp_get_next_mib(oid, oid_len);
+    mib = snmp_get_next_mib(registry, oid, oid_len);
 
     if (mib != NULL) {
       start_oid     = mib->base_oid;
@@ -835,7 +1363,13 @@ snmp_get_next_node_instance_from_oid(const u32_t *oid, u8_t oid_len, snmp_valida
     u8_t oid_instance_len;
 
     /* check if OID directly references a node inside current MIB, in this case we have to ask this node for the next instance */
-    mn = snmp_mib_tree_resolve_exact(mib, start_oid, start_oid_len, &oid_instance_len);
+    if (hint_node != NULL) {
+      mn = hint_node;
+      oid_instance_len = start_oid_len - hint->node_oid_len;
+      hint_node = NULL;
+    } else {
+      mn = snmp_mib_tree_resolve_exact(mib, start_oid, start_oid_len, &oid_instance_len);
+    }
     if (mn != NULL) {
       snmp_oid_assign(node_oid, start_oid, start_oid_len - oid_instance_len); /* set oid to node */
       snmp_oid_assign(&node_instance->instance_oid, start_oid + (start_oid_len - oid_instance_len), oid_instance_len); /* set (relative) instance oid */
@@ -916,7 +1450,7 @@ snmp_get_next_node_instance_from_oid(const u32_t *oid, u8_t oid_len, snmp_valida
       MIB having .3 as root node may exist)
       */
       const struct snmp_mib *intermediate_mib;
-      intermediate_mib = snmp_get_mib_between(start_oid, start_oid_len, node_oid->id, node_oid->len);
+      intermediate_mib = snmp_get_mib_between(registry, start_oid, start_oid_len, node_oid->id, node_oid->len);
 
       if (intermediate_mib != NULL) {
         /* search for first node inside intermediate mib in next loop */
@@ -938,7 +1472,7 @@ snmp_get_next_node_instance_from_oid(const u32_t *oid, u8_t oid_len, snmp_valida
       3. take the next closest MIB (not being related to the current MIB)
       */
       const struct snmp_mib *next_mib;
-      next_mib = snmp_get_next_mib(start_oid, start_oid_len); /* returns MIB's related to point 1 and 3 */
+      next_mib = snmp_get_next_mib(registry, start_oid, start_oid_len); /* returns MIB's related to point 1 and 3 */
 
       /* is the found MIB an inner MIB? (point 1) */
       if ((next_mib != NULL) && (next_mib->base_oid_len > mib->base_oid_len) &&
@@ -950,7 +1484,7 @@ snmp_get_next_node_instance_from_oid(const u32_t *oid, u8_t oid_len, snmp_valida
       } else {
         /* check if there is a surrounding mib where to continue (point 2) (only possible if OID length > 1) */
         if (mib->base_oid_len > 1) {
-          mib = snmp_get_mib_from_oid(mib->base_oid, mib->base_oid_len - 1);
+          mib = snmp_get_mib_from_oid(registry, mib->base_oid, mib->base_oid_len - 1);
 
           if (mib == NULL) {
             /* no surrounding mib, use next mib encountered above (point 3) */
@@ -972,9 +1506,60 @@ snmp_get_next_node_instance_from_oid(const u32_t *oid, u8_t oid_len, snmp_valida
     return SNMP_ERR_ENDOFMIBVIEW;
   }
 
+#if SNMP_WALK_CACHE_SIZE > 0
+  if (hint != NULL) {
+    snmp_oid_assign(&hint->oid, node_oid->id, node_oid->len);
+    hint->mib          = mib;
+    hint->node         = mn;
+    hint->node_oid_len = node_oid->len - node_instance->instance_oid.len;
+    /* hints of requests that started before a change must not outlive it */
+    hint->generation   = hint->request_generation;
+  }
+#endif
+
   return SNMP_ERR_NOERROR;
 }
 
+/**
+ * Returns the subnode of a tree node with the smallest OID >= subnode_oid, NULL if there is none.
+ */
+static const struct snmp_node *
+snmp_tree_node_find_subnode(const struct snmp_tree_node *tree_node, u32_t subnode_oid)
+{
+  const struct snmp_node *const *node = tree_node->subnodes;
+  const struct snmp_node *subnode = NULL;
+  u16_t i;
+
+#if SNMP_SORTED_TREE_NODES
+  if (snmp_mibs_sorted) {
+    u16_t lower = 0;
+    u16_t upper = tree_node->subnode_count;
+
+    /* first subnode not below subnode_oid */
+    while (lower < upper) {
+      u16_t middle = (u16_t)(lower + ((upper - lower) >> 1));
+      if (node[middle]->oid < subnode_oid) {
+        lower = (u16_t)(middle + 1);
+      } else {
+        upper = middle;
+      }
+    }
+
+    return (lower < tree_node->subnode_count) ? node[lower] : NULL;
+  }
+#endif
+
+  for (i = 0; i < tree_node->subnode_count; i++) {
+    if (node[i]->oid == subnode_oid) {
+      return node[i];
+    } else if ((node[i]->oid > subnode_oid) && ((subnode == NULL) || (node[i]->oid < subnode->oid))) {
+      subnode = node[i];
+    }
+  }
+
+  return subnode;
+}
+
 /**
  * Searches tree for the supplied object identifier.
  *
@@ -982,21 +1567,15 @@ snmp_get_next_node_instance_from_oid(const u32_t *oid, u8_t oid_len, snmp_valida
 const struct snmp_node *
 snmp_mib_tree_resolve_exact(const struct snmp_mib *mib, const u32_t *oid, u8_t oid_len, u8_t *oid_instance_len)
 {
-  const struct snmp_node *const *node = &mib->root_node;
+  const struct snmp_node *node = mib->root_node;
   u8_t oid_offset = mib->base_oid_len;
 
-  while ((oid_offset < oid_len) && ((*node)->node_type == SNMP_NODE_TREE)) {
+  while ((oid_offset < oid_len) && (node->node_type == SNMP_NODE_TREE)) {
     /* search for matching sub node */
     u32_t subnode_oid = *(oid + oid_offset);
 
-    u32_t i = (*(const struct snmp_tree_node * const *)node)->subnode_count;
-    node    = (*(const struct snmp_tree_node * const *)node)->subnodes;
-    while ((i > 0) && ((*node)->oid != subnode_oid)) {
-      node++;
-      i--;
-    }
-
-    if (i == 0) {
+    node = snmp_tree_node_find_subnode((const struct snmp_tree_node *)(const void *)node, subnode_oid);
+    if ((node == NULL) || (node->oid != subnode_oid)) {
       /* no matching subnode found */
       return NULL;
     }
@@ -1004,10 +1583,10 @@ snmp_mib_tree_resolve_exact(const struct snmp_mib *mib, const u32_t *oid, u8_t o
     oid_offset++;
   }
 
-  if ((*node)->node_type != SNMP_NODE_TREE) {
+  if (node->node_type != SNMP_NODE_TREE) {
     /* we found a leaf node */
     *oid_instance_len = oid_len - oid_offset;
-    return (*node);
+    return node;
   }
 
   return NULL;
@@ -1017,7 +1596,7 @@ const struct snmp_node *
 snmp_mib_tree_resolve_next(const struct snmp_mib *mib, const u32_t *oid, u8_t oid_len, struct snmp_obj_id *oidret)
 {
   u8_t  oid_offset = mib->base_oid_len;
-  const struct snmp_node *const *node;
+  const struct snmp_node *node;
   const struct snmp_tree_node *node_stack[SNMP_MAX_OBJ_ID_LEN];
   s32_t nsi = 0; /* NodeStackIndex */
   u32_t subnode_oid;
@@ -1031,22 +1610,15 @@ snmp_mib_tree_resolve_next(const struct snmp_mib *mib, const u32_t *oid, u8_t oi
   node_stack[nsi] = (const struct snmp_tree_node *)(const void *)mib->root_node;
   while (oid_offset < oid_len) {
     /* search for matching sub node */
-    u32_t i = node_stack[nsi]->subnode_count;
-    node    = node_stack[nsi]->subnodes;
-
     subnode_oid = *(oid + oid_offset);
 
-    while ((i > 0) && ((*node)->oid != subnode_oid)) {
-      node++;
-      i--;
-    }
-
-    if ((i == 0) || ((*node)->node_type != SNMP_NODE_TREE)) {
+    node = snmp_tree_node_find_subnode(node_stack[nsi], subnode_oid);
+    if ((node == NULL) || (node->oid != subnode_oid) || (node->node_type != SNMP_NODE_TREE)) {
       /* no (matching) tree-subnode found */
       break;
     }
     nsi++;
-    node_stack[nsi] = (const struct snmp_tree_node *)(const void *)(*node);
+    node_stack[nsi] = (const struct snmp_tree_node *)(const void *)node;
 
     oid_offset++;
   }
@@ -1060,22 +1632,8 @@ snmp_mib_tree_resolve_next(const struct snmp_mib *mib, const u32_t *oid, u8_t oi
   }
 
   while (nsi >= 0) {
-    const struct snmp_node *subnode = NULL;
-
     /* find next node on current level */
-    s32_t i        = node_stack[nsi]->subnode_count;
-    node           = node_stack[nsi]->subnodes;
-    while (i > 0) {
-      if ((*node)->oid == subnode_oid) {
-        subnode = *node;
-        break;
-      } else if (((*node)->oid > subnode_oid) && ((subnode == NULL) || ((*node)->oid < subnode->oid))) {
-        subnode = *node;
-      }
-
-      node++;
-      i--;
-    }
+    const struct snmp_node *subnode = snmp_tree_node_find_subnode(node_stack[nsi], subnode_oid);
 
     if (subnode == NULL) {
       /* no further node found on this level, go one level up and start searching with index of current node*/
@@ -1089,6 +1647,8 @@ snmp_mib_tree_resolve_next(const struct snmp_mib *mib, const u32_t *oid, u8_t oi
         subnode_oid = 0;
       } else {
         /* we found a leaf node -> fill oidret and return it */
+        s32_t i;
+
         snmp_oid_assign(oidret, mib->base_oid, mib->base_oid_len);
         i = 1;
         while (i <= nsi) {
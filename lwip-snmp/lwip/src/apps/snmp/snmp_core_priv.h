@@ -38,8 +38,14 @@
 #if LWIP_SNMP /* don't build if not configured for use in lwipopts.h */
 
 #include "lwip/apps/snmp_core.h"
+#include "lwip/sys.h"
 #include "snmp_asn1.h"
 
+/* checked here, so every file using the cells stops before failing on undeclared GetBulk cursors */
+#if (SNMP_TABLE_NEXT_CELLS > 0) && (SNMP_GETBULK_CURSORS <= 0)
+#error "SNMP_TABLE_NEXT_CELLS keeps the cells with the GetBulk cursors, define SNMP_GETBULK_CURSORS>=1 in your lwipopts.h"
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -65,14 +71,95 @@ extern "C" {
 #define SNMP_ERR_NOSUCHOBJECT         SNMP_VARBIND_EXCEPTION_OFFSET + SNMP_ASN1_CONTEXT_VARBIND_NO_SUCH_OBJECT
 #define SNMP_ERR_ENDOFMIBVIEW         SNMP_VARBIND_EXCEPTION_OFFSET + SNMP_ASN1_CONTEXT_VARBIND_END_OF_MIB_VIEW
 
+/* snmp_stats updates, atomic if more than one worker may update them at the same time */
+#if SNMP_WORKER_THREADS > 1
+/* shard for updates made outside of a request, protect with SYS_ARCH_PROTECT */
+#define SNMP_STATS_SHARED snmp_stats_shards[SNMP_WORKER_THREADS]
+#define SNMP_STATS_ADD(x, n) do { \
+    SYS_ARCH_DECL_PROTECT(lev); \
+    SYS_ARCH_PROTECT(lev); \
+    SNMP_STATS_SHARED.x += (n); \
+    SYS_ARCH_UNPROTECT(lev); \
+  } while (0)
+/* updates made while processing a request go to the shard of its worker without locking */
+#define SNMP_REQUEST_STATS_ADD(request, x, n) do { \
+    if ((request)->stats != NULL) { \
+      (request)->stats->x += (n); \
+    } else { \
+      SNMP_STATS_ADD(x, n); \
+    } \
+  } while (0)
+
+struct snmp_statistics *snmp_stats_shard_alloc(void);
+void snmp_stats_shard_free(struct snmp_statistics *shard);
+#else
+#define SNMP_STATS_SHARED snmp_stats
+#define SNMP_STATS_ADD(x, n) snmp_stats.x += (n)
+#define SNMP_REQUEST_STATS_ADD(request, x, n) SNMP_STATS_ADD(x, n)
+#endif
+#define SNMP_STATS_INC(x) SNMP_STATS_ADD(x, 1)
+#define SNMP_REQUEST_STATS_INC(request, x) SNMP_REQUEST_STATS_ADD(request, x, 1)
+
+/* phase timing, see SNMP_PROFILE */
+#if SNMP_PROFILE
+#define SNMP_PROFILE_DECL(t)    u32_t t;
+#define SNMP_PROFILE_BEGIN(t)   (t) = snmp_profile_now()
+#define SNMP_PROFILE_ELAPSED(t) ((u32_t)(snmp_profile_now() - (t)))
+#else
+#define SNMP_PROFILE_DECL(t)
+#define SNMP_PROFILE_BEGIN(t)
+#endif
+
 
 const struct snmp_node *snmp_mib_tree_resolve_exact(const struct snmp_mib *mib, const u32_t *oid, u8_t oid_len, u8_t *oid_instance_len);
 const struct snmp_node *snmp_mib_tree_resolve_next(const struct snmp_mib *mib, const u32_t *oid, u8_t oid_len, struct snmp_obj_id *oidret);
 
 typedef u8_t (*snmp_validate_node_instance_method)(struct snmp_node_instance *, void *);
 
-u8_t snmp_get_node_instance_from_oid(const u32_t *oid, u8_t oid_len, struct snmp_node_instance *node_instance);
-u8_t snmp_get_next_node_instance_from_oid(const u32_t *oid, u8_t oid_len, snmp_validate_node_instance_method validate_node_instance_method, void *validate_node_instance_arg, struct snmp_obj_id *node_oid, struct snmp_node_instance *node_instance);
+/** where snmp_get_next_node_instance_from_oid() returned an OID, to continue there without resolving it again */
+struct snmp_next_hint {
+  /* OID returned */
+  struct snmp_obj_id oid;
+  const struct snmp_mib *mib;
+  const struct snmp_node *node;
+  /* length of the node part of oid */
+  u8_t node_oid_len;
+  /* snmp_next_hint_generation when the request taking the hint started, the hint is valid until it changes */
+  u32_t generation;
+  /* snmp_next_hint_generation when the request using the hint started */
+  u32_t request_generation;
+  /* 1 if the last lookup continued at node, 0 if it resolved the OID again */
+  u8_t hit;
+};
+
+#if SNMP_WALK_CACHE_SIZE > 0
+extern u32_t snmp_next_hint_generation;
+void snmp_next_hint_invalidate(void);
+#endif
+
+#if SNMP_VALUE_CACHE_SIZE > 0
+void snmp_value_cache_flush(void);
+#endif
+
+/* MIBs in use sorted by base OID (SNMP_MIB_REGISTRY_SIZE > 0), NULL if snmp_mibs are scanned */
+struct snmp_mib_registry;
+
+#if SNMP_MIB_REGISTRY_SIZE > 0
+/* one reader slot per worker, identified by its statistics shard */
+#if SNMP_WORKER_THREADS > 1
+#define SNMP_MIB_REGISTRY_READERS SNMP_WORKER_THREADS
+/* reader slot of requests without a statistics shard, shared with SYS_ARCH_PROTECT */
+#define SNMP_MIB_REGISTRY_SHARED_READER SNMP_WORKER_THREADS
+#else
+#define SNMP_MIB_REGISTRY_READERS 1
+#endif
+
+const struct snmp_mib_registry *snmp_mib_registry_acquire(u8_t reader);
+void snmp_mib_registry_release(u8_t reader, const struct snmp_mib_registry *registry);
+#endif
+
+u8_t snmp_get_node_instance_from_oid(const struct snmp_mib_registry *registry, const u32_t *oid, u8_t oid_len, struct snmp_node_instance *node_instance);
+u8_t snmp_get_next_node_instance_from_oid(const struct snmp_mib_registry *registry, const u32_t *oid, u8_t oid_len, snmp_validate_node_instance_method validate_node_instance_method, void *validate_node_instance_arg, struct snmp_obj_id *node_oid, struct snmp_node_instance *node_instance, struct snmp_next_hint *hint);
 
 #ifdef __cplusplus
 }
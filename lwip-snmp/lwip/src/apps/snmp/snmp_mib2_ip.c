@@ -303,6 +303,36 @@ ip_AddrTable_get_next_cell_instance_and_value(const u32_t *column, struct snmp_o
   return SNMP_ERR_NOSUCHINSTANCE;
 }
 
+#if SNMP_TABLE_NEXT_CELLS > 0
+static snmp_err_t
+ip_AddrTable_get_next_cells(const u32_t *column, const struct snmp_obj_id *row_oid, struct snmp_next_cells *cells)
+{
+  struct netif *netif;
+  u8_t i;
+
+  /* init cells to collect the next rows */
+  snmp_next_cells_init(cells, row_oid->id, row_oid->len);
+
+  /* iterate over all possible OIDs to find the next ones */
+  NETIF_FOREACH(netif) {
+    u32_t test_oid[LWIP_ARRAYSIZE(ip_AddrTable_oid_ranges)];
+    snmp_ip4_to_oid(netif_ip4_addr(netif), &test_oid[0]);
+
+    /* check generated OID: is it a candidate for the next ones? */
+    snmp_next_cells_check(cells, test_oid, LWIP_ARRAYSIZE(ip_AddrTable_oid_ranges), netif);
+  }
+
+  /* fill in object properties, replacing the netif references */
+  for (i = 0; i < cells->count; i++) {
+    if (ip_AddrTable_get_cell_value_core((struct netif *)cells->value[i].ptr, column, &cells->value[i], &cells->value_len[i]) != SNMP_ERR_NOERROR) {
+      return SNMP_ERR_NOSUCHINSTANCE;
+    }
+  }
+
+  return SNMP_ERR_NOERROR;
+}
+#endif /* SNMP_TABLE_NEXT_CELLS > 0 */
+
 /* --- ipRouteTable --- */
 
 /* list of allowed value ranges for incoming OID */
@@ -469,6 +499,48 @@ ip_RouteTable_get_next_cell_instance_and_value(const u32_t *column, struct snmp_
   }
 }
 
+#if SNMP_TABLE_NEXT_CELLS > 0
+static snmp_err_t
+ip_RouteTable_get_next_cells(const u32_t *column, const struct snmp_obj_id *row_oid, struct snmp_next_cells *cells)
+{
+  struct netif *netif;
+  u32_t test_oid[LWIP_ARRAYSIZE(ip_RouteTable_oid_ranges)];
+  u8_t i;
+
+  /* init cells to collect the next rows */
+  snmp_next_cells_init(cells, row_oid->id, row_oid->len);
+
+  /* check default route */
+  if (netif_default != NULL) {
+    snmp_ip4_to_oid(IP4_ADDR_ANY4, &test_oid[0]);
+    snmp_next_cells_check(cells, test_oid, LWIP_ARRAYSIZE(ip_RouteTable_oid_ranges), netif_default);
+  }
+
+  /* iterate over all possible OIDs to find the next ones */
+  NETIF_FOREACH(netif) {
+    ip4_addr_t dst;
+    ip4_addr_get_network(&dst, netif_ip4_addr(netif), netif_ip4_netmask(netif));
+
+    /* check generated OID: is it a candidate for the next ones? */
+    if (!ip4_addr_isany_val(dst)) {
+      snmp_ip4_to_oid(&dst, &test_oid[0]);
+      snmp_next_cells_check(cells, test_oid, LWIP_ARRAYSIZE(ip_RouteTable_oid_ranges), netif);
+    }
+  }
+
+  /* fill in object properties, replacing the netif references */
+  for (i = 0; i < cells->count; i++) {
+    ip4_addr_t dst;
+    snmp_oid_to_ip4(cells->row_oid[i], &dst);
+    if (ip_RouteTable_get_cell_value_core((struct netif *)cells->value[i].ptr, ip4_addr_isany_val(dst), column, &cells->value[i], &cells->value_len[i]) != SNMP_ERR_NOERROR) {
+      return SNMP_ERR_NOSUCHINSTANCE;
+    }
+  }
+
+  return SNMP_ERR_NOERROR;
+}
+#endif /* SNMP_TABLE_NEXT_CELLS > 0 */
+
 #if LWIP_ARP && LWIP_IPV4
 /* --- ipNetToMediaTable --- */
 
@@ -584,6 +656,44 @@ ip_NetToMediaTable_get_next_cell_instance_and_value(const u32_t *column, struct
   return SNMP_ERR_NOSUCHINSTANCE;
 }
 
+#if SNMP_TABLE_NEXT_CELLS > 0
+static snmp_err_t
+ip_NetToMediaTable_get_next_cells(const u32_t *column, const struct snmp_obj_id *row_oid, struct snmp_next_cells *cells)
+{
+  size_t i;
+  u8_t j;
+
+  /* init cells to collect the next rows */
+  snmp_next_cells_init(cells, row_oid->id, row_oid->len);
+
+  /* iterate over all possible OIDs to find the next ones */
+  for (i = 0; i < ARP_TABLE_SIZE; i++) {
+    ip4_addr_t *ip;
+    struct netif *netif;
+    struct eth_addr *ethaddr;
+
+    if (etharp_get_entry(i, &ip, &netif, &ethaddr)) {
+      u32_t test_oid[LWIP_ARRAYSIZE(ip_NetToMediaTable_oid_ranges)];
+
+      test_oid[0] = netif_to_num(netif);
+      snmp_ip4_to_oid(ip, &test_oid[1]);
+
+      /* check generated OID: is it a candidate for the next ones? */
+      snmp_next_cells_check(cells, test_oid, LWIP_ARRAYSIZE(ip_NetToMediaTable_oid_ranges), LWIP_PTR_NUMERIC_CAST(void *, i));
+    }
+  }
+
+  /* fill in object properties, replacing the ARP table indexes */
+  for (j = 0; j < cells->count; j++) {
+    if (ip_NetToMediaTable_get_cell_value_core(LWIP_PTR_NUMERIC_CAST(size_t, cells->value[j].ptr), column, &cells->value[j], &cells->value_len[j]) != SNMP_ERR_NOERROR) {
+      return SNMP_ERR_NOSUCHINSTANCE;
+    }
+  }
+
+  return SNMP_ERR_NOERROR;
+}
+#endif /* SNMP_TABLE_NEXT_CELLS > 0 */
+
 #endif /* LWIP_ARP && LWIP_IPV4 */
 
 static const struct snmp_scalar_node ip_Forwarding      = SNMP_SCALAR_CREATE_NODE(1, SNMP_NODE_INSTANCE_READ_WRITE, SNMP_ASN1_TYPE_INTEGER, ip_get_value, ip_set_test, ip_set_value);
@@ -608,43 +718,43 @@ static const struct snmp_scalar_node ip_FragCreates     = SNMP_SCALAR_CREATE_NOD
 static const struct snmp_scalar_node ip_RoutingDiscards = SNMP_SCALAR_CREATE_NODE_READONLY(23, SNMP_ASN1_TYPE_COUNTER, ip_get_value);
 
 static const struct snmp_table_simple_col_def ip_AddrTable_columns[] = {
-  { 1, SNMP_ASN1_TYPE_IPADDR,  SNMP_VARIANT_VALUE_TYPE_U32 }, /* ipAdEntAddr */
-  { 2, SNMP_ASN1_TYPE_INTEGER, SNMP_VARIANT_VALUE_TYPE_U32 }, /* ipAdEntIfIndex */
-  { 3, SNMP_ASN1_TYPE_IPADDR,  SNMP_VARIANT_VALUE_TYPE_U32 }, /* ipAdEntNetMask */
-  { 4, SNMP_ASN1_TYPE_INTEGER, SNMP_VARIANT_VALUE_TYPE_U32 }, /* ipAdEntBcastAddr */
-  { 5, SNMP_ASN1_TYPE_INTEGER, SNMP_VARIANT_VALUE_TYPE_U32 }  /* ipAdEntReasmMaxSize */
+  { 1, SNMP_ASN1_TYPE_IPADDR,  SNMP_VARIANT_VALUE_TYPE_U32 SNMP_NODE_CACHE_TTL(0) }, /* ipAdEntAddr */
+  { 2, SNMP_ASN1_TYPE_INTEGER, SNMP_VARIANT_VALUE_TYPE_U32 SNMP_NODE_CACHE_TTL(0) }, /* ipAdEntIfIndex */
+  { 3, SNMP_ASN1_TYPE_IPADDR,  SNMP_VARIANT_VALUE_TYPE_U32 SNMP_NODE_CACHE_TTL(0) }, /* ipAdEntNetMask */
+  { 4, SNMP_ASN1_TYPE_INTEGER, SNMP_VARIANT_VALUE_TYPE_U32 SNMP_NODE_CACHE_TTL(0) }, /* ipAdEntBcastAddr */
+  { 5, SNMP_ASN1_TYPE_INTEGER, SNMP_VARIANT_VALUE_TYPE_U32 SNMP_NODE_CACHE_TTL(0) }  /* ipAdEntReasmMaxSize */
 };
 
-static const struct snmp_table_simple_node ip_AddrTable = SNMP_TABLE_CREATE_SIMPLE(20, ip_AddrTable_columns, ip_AddrTable_get_cell_value, ip_AddrTable_get_next_cell_instance_and_value);
+static const struct snmp_table_simple_node ip_AddrTable = SNMP_TABLE_CREATE_SIMPLE_NEXT_CELLS(20, ip_AddrTable_columns, ip_AddrTable_get_cell_value, ip_AddrTable_get_next_cell_instance_and_value, ip_AddrTable_get_next_cells);
 
 static const struct snmp_table_simple_col_def ip_RouteTable_columns[] = {
-  {  1, SNMP_ASN1_TYPE_IPADDR,    SNMP_VARIANT_VALUE_TYPE_U32 }, /* ipRouteDest */
-  {  2, SNMP_ASN1_TYPE_INTEGER,   SNMP_VARIANT_VALUE_TYPE_U32 }, /* ipRouteIfIndex */
-  {  3, SNMP_ASN1_TYPE_INTEGER,   SNMP_VARIANT_VALUE_TYPE_S32 }, /* ipRouteMetric1 */
-  {  4, SNMP_ASN1_TYPE_INTEGER,   SNMP_VARIANT_VALUE_TYPE_S32 }, /* ipRouteMetric2 */
-  {  5, SNMP_ASN1_TYPE_INTEGER,   SNMP_VARIANT_VALUE_TYPE_S32 }, /* ipRouteMetric3 */
-  {  6, SNMP_ASN1_TYPE_INTEGER,   SNMP_VARIANT_VALUE_TYPE_S32 }, /* ipRouteMetric4 */
-  {  7, SNMP_ASN1_TYPE_IPADDR,    SNMP_VARIANT_VALUE_TYPE_U32 }, /* ipRouteNextHop */
-  {  8, SNMP_ASN1_TYPE_INTEGER,   SNMP_VARIANT_VALUE_TYPE_U32 }, /* ipRouteType */
-  {  9, SNMP_ASN1_TYPE_INTEGER,   SNMP_VARIANT_VALUE_TYPE_U32 }, /* ipRouteProto */
-  { 10, SNMP_ASN1_TYPE_INTEGER,   SNMP_VARIANT_VALUE_TYPE_U32 }, /* ipRouteAge */
-  { 11, SNMP_ASN1_TYPE_IPADDR,    SNMP_VARIANT_VALUE_TYPE_U32 }, /* ipRouteMask */
-  { 12, SNMP_ASN1_TYPE_INTEGER,   SNMP_VARIANT_VALUE_TYPE_S32 }, /* ipRouteMetric5 */
-  { 13, SNMP_ASN1_TYPE_OBJECT_ID, SNMP_VARIANT_VALUE_TYPE_PTR }  /* ipRouteInfo */
+  {  1, SNMP_ASN1_TYPE_IPADDR,    SNMP_VARIANT_VALUE_TYPE_U32 SNMP_NODE_CACHE_TTL(0) }, /* ipRouteDest */
+  {  2, SNMP_ASN1_TYPE_INTEGER,   SNMP_VARIANT_VALUE_TYPE_U32 SNMP_NODE_CACHE_TTL(0) }, /* ipRouteIfIndex */
+  {  3, SNMP_ASN1_TYPE_INTEGER,   SNMP_VARIANT_VALUE_TYPE_S32 SNMP_NODE_CACHE_TTL(0) }, /* ipRouteMetric1 */
+  {  4, SNMP_ASN1_TYPE_INTEGER,   SNMP_VARIANT_VALUE_TYPE_S32 SNMP_NODE_CACHE_TTL(0) }, /* ipRouteMetric2 */
+  {  5, SNMP_ASN1_TYPE_INTEGER,   SNMP_VARIANT_VALUE_TYPE_S32 SNMP_NODE_CACHE_TTL(0) }, /* ipRouteMetric3 */
+  {  6, SNMP_ASN1_TYPE_INTEGER,   SNMP_VARIANT_VALUE_TYPE_S32 SNMP_NODE_CACHE_TTL(0) }, /* ipRouteMetric4 */
+  {  7, SNMP_ASN1_TYPE_IPADDR,    SNMP_VARIANT_VALUE_TYPE_U32 SNMP_NODE_CACHE_TTL(0) }, /* ipRouteNextHop */
+  {  8, SNMP_ASN1_TYPE_INTEGER,   SNMP_VARIANT_VALUE_TYPE_U32 SNMP_NODE_CACHE_TTL(0) }, /* ipRouteType */
+  {  9, SNMP_ASN1_TYPE_INTEGER,   SNMP_VARIANT_VALUE_TYPE_U32 SNMP_NODE_CACHE_TTL(0) }, /* ipRouteProto */
+  { 10, SNMP_ASN1_TYPE_INTEGER,   SNMP_VARIANT_VALUE_TYPE_U32 SNMP_NODE_CACHE_TTL(0) }, /* ipRouteAge */
+  { 11, SNMP_ASN1_TYPE_IPADDR,    SNMP_VARIANT_VALUE_TYPE_U32 SNMP_NODE_CACHE_TTL(0) }, /* ipRouteMask */
+  { 12, SNMP_ASN1_TYPE_INTEGER,   SNMP_VARIANT_VALUE_TYPE_S32 SNMP_NODE_CACHE_TTL(0) }, /* ipRouteMetric5 */
+  { 13, SNMP_ASN1_TYPE_OBJECT_ID, SNMP_VARIANT_VALUE_TYPE_PTR SNMP_NODE_CACHE_TTL(0) }  /* ipRouteInfo */
 };
 
-static const struct snmp_table_simple_node ip_RouteTable = SNMP_TABLE_CREATE_SIMPLE(21, ip_RouteTable_columns, ip_RouteTable_get_cell_value, ip_RouteTable_get_next_cell_instance_and_value);
+static const struct snmp_table_simple_node ip_RouteTable = SNMP_TABLE_CREATE_SIMPLE_NEXT_CELLS(21, ip_RouteTable_columns, ip_RouteTable_get_cell_value, ip_RouteTable_get_next_cell_instance_and_value, ip_RouteTable_get_next_cells);
 #endif /* LWIP_IPV4 */
 
 #if LWIP_ARP && LWIP_IPV4
 static const struct snmp_table_simple_col_def ip_NetToMediaTable_columns[] = {
-  {  1, SNMP_ASN1_TYPE_INTEGER,      SNMP_VARIANT_VALUE_TYPE_U32 }, /* ipNetToMediaIfIndex */
-  {  2, SNMP_ASN1_TYPE_OCTET_STRING, SNMP_VARIANT_VALUE_TYPE_PTR }, /* ipNetToMediaPhysAddress */
-  {  3, SNMP_ASN1_TYPE_IPADDR,       SNMP_VARIANT_VALUE_TYPE_U32 }, /* ipNetToMediaNetAddress */
-  {  4, SNMP_ASN1_TYPE_INTEGER,      SNMP_VARIANT_VALUE_TYPE_U32 }  /* ipNetToMediaType */
+  {  1, SNMP_ASN1_TYPE_INTEGER,      SNMP_VARIANT_VALUE_TYPE_U32 SNMP_NODE_CACHE_TTL(0) }, /* ipNetToMediaIfIndex */
+  {  2, SNMP_ASN1_TYPE_OCTET_STRING, SNMP_VARIANT_VALUE_TYPE_PTR SNMP_NODE_CACHE_TTL(0) }, /* ipNetToMediaPhysAddress */
+  {  3, SNMP_ASN1_TYPE_IPADDR,       SNMP_VARIANT_VALUE_TYPE_U32 SNMP_NODE_CACHE_TTL(0) }, /* ipNetToMediaNetAddress */
+  {  4, SNMP_ASN1_TYPE_INTEGER,      SNMP_VARIANT_VALUE_TYPE_U32 SNMP_NODE_CACHE_TTL(0) }  /* ipNetToMediaType */
 };
 
-static const struct snmp_table_simple_node ip_NetToMediaTable = SNMP_TABLE_CREATE_SIMPLE(22, ip_NetToMediaTable_columns, ip_NetToMediaTable_get_cell_value, ip_NetToMediaTable_get_next_cell_instance_and_value);
+static const struct snmp_table_simple_node ip_NetToMediaTable = SNMP_TABLE_CREATE_SIMPLE_NEXT_CELLS(22, ip_NetToMediaTable_columns, ip_NetToMediaTable_get_cell_value, ip_NetToMediaTable_get_next_cell_instance_and_value, ip_NetToMediaTable_get_next_cells);
 #endif /* LWIP_ARP && LWIP_IPV4 */
 
 #if LWIP_IPV4
@@ -664,7 +774,7 @@ CREATE_LWIP_SYNC_NODE(12, ip_OutNoRoutes)
 CREATE_LWIP_SYNC_NODE(13, ip_ReasmTimeout)
 CREATE_LWIP_SYNC_NODE(14, ip_ReasmReqds)
 CREATE_LWIP_SYNC_NODE(15, ip_ReasmOKs)
-CREATE_LWIP_SYNC_NODE(15, ip_ReasmFails)
+CREATE_LWIP_SYNC_NODE(16, ip_ReasmFails)
 CREATE_LWIP_SYNC_NODE(17, ip_FragOKs)
 CREATE_LWIP_SYNC_NODE(18, ip_FragFails)
 CREATE_LWIP_SYNC_NODE(19, ip_FragCreates)
@@ -711,12 +821,12 @@ const struct snmp_tree_node snmp_mib2_ip_root = SNMP_CREATE_TREE_NODE(4, ip_node
 #if LWIP_ARP && LWIP_IPV4
 /* at node table is a subset of ip_nettomedia table (same rows but less columns) */
 static const struct snmp_table_simple_col_def at_Table_columns[] = {
-  { 1, SNMP_ASN1_TYPE_INTEGER,      SNMP_VARIANT_VALUE_TYPE_U32 }, /* atIfIndex */
-  { 2, SNMP_ASN1_TYPE_OCTET_STRING, SNMP_VARIANT_VALUE_TYPE_PTR }, /* atPhysAddress */
-  { 3, SNMP_ASN1_TYPE_IPADDR,       SNMP_VARIANT_VALUE_TYPE_U32 }  /* atNetAddress */
+  { 1, SNMP_ASN1_TYPE_INTEGER,      SNMP_VARIANT_VALUE_TYPE_U32 SNMP_NODE_CACHE_TTL(0) }, /* atIfIndex */
+  { 2, SNMP_ASN1_TYPE_OCTET_STRING, SNMP_VARIANT_VALUE_TYPE_PTR SNMP_NODE_CACHE_TTL(0) }, /* atPhysAddress */
+  { 3, SNMP_ASN1_TYPE_IPADDR,       SNMP_VARIANT_VALUE_TYPE_U32 SNMP_NODE_CACHE_TTL(0) }  /* atNetAddress */
 };
 
-static const struct snmp_table_simple_node at_Table = SNMP_TABLE_CREATE_SIMPLE(1, at_Table_columns, ip_NetToMediaTable_get_cell_value, ip_NetToMediaTable_get_next_cell_instance_and_value);
+static const struct snmp_table_simple_node at_Table = SNMP_TABLE_CREATE_SIMPLE_NEXT_CELLS(1, at_Table_columns, ip_NetToMediaTable_get_cell_value, ip_NetToMediaTable_get_next_cell_instance_and_value, ip_NetToMediaTable_get_next_cells);
 
 /* the following nodes access variables in LWIP stack from SNMP worker thread and must therefore be synced to LWIP (TCPIP) thread */
 CREATE_LWIP_SYNC_NODE(1, at_Table)
@@ -51,85 +51,85 @@ snmp_get_value(const struct snmp_scalar_array_node_def *node, void *value)
   u32_t *uint_ptr = (u32_t *)value;
   switch (node->oid) {
     case 1: /* snmpInPkts */
-      *uint_ptr = snmp_stats.inpkts;
+      *uint_ptr = SNMP_STATS_GET(inpkts);
       break;
     case 2: /* snmpOutPkts */
-      *uint_ptr = snmp_stats.outpkts;
+      *uint_ptr = SNMP_STATS_GET(outpkts);
       break;
     case 3: /* snmpInBadVersions */
-      *uint_ptr = snmp_stats.inbadversions;
+      *uint_ptr = SNMP_STATS_GET(inbadversions);
       break;
     case 4: /* snmpInBadCommunityNames */
-      *uint_ptr = snmp_stats.inbadcommunitynames;
+      *uint_ptr = SNMP_STATS_GET(inbadcommunitynames);
       break;
     case 5: /* snmpInBadCommunityUses */
-      *uint_ptr = snmp_stats.inbadcommunityuses;
+      *uint_ptr = SNMP_STATS_GET(inbadcommunityuses);
       break;
     case 6: /* snmpInASNParseErrs */
-      *uint_ptr = snmp_stats.inasnparseerrs;
+      *uint_ptr = SNMP_STATS_GET(inasnparseerrs);
       break;
     case 8: /* snmpInTooBigs */
-      *uint_ptr = snmp_stats.intoobigs;
+      *uint_ptr = SNMP_STATS_GET(intoobigs);
       break;
     case 9: /* snmpInNoSuchNames */
-      *uint_ptr = snmp_stats.innosuchnames;
+      *uint_ptr = SNMP_STATS_GET(innosuchnames);
       break;
     case 10: /* snmpInBadValues */
-      *uint_ptr = snmp_stats.inbadvalues;
+      *uint_ptr = SNMP_STATS_GET(inbadvalues);
       break;
     case 11: /* snmpInReadOnlys */
-      *uint_ptr = snmp_stats.inreadonlys;
+      *uint_ptr = SNMP_STATS_GET(inreadonlys);
       break;
     case 12: /* snmpInGenErrs */
-      *uint_ptr = snmp_stats.ingenerrs;
+      *uint_ptr = SNMP_STATS_GET(ingenerrs);
       break;
     case 13: /* snmpInTotalReqVars */
-      *uint_ptr = snmp_stats.intotalreqvars;
+      *uint_ptr = SNMP_STATS_GET(intotalreqvars);
       break;
     case 14: /* snmpInTotalSetVars */
-      *uint_ptr = snmp_stats.intotalsetvars;
+      *uint_ptr = SNMP_STATS_GET(intotalsetvars);
       break;
     case 15: /* snmpInGetRequests */
-      *uint_ptr = snmp_stats.ingetrequests;
+      *uint_ptr = SNMP_STATS_GET(ingetrequests);
       break;
     case 16: /* snmpInGetNexts */
-      *uint_ptr = snmp_stats.ingetnexts;
+      *uint_ptr = SNMP_STATS_GET(ingetnexts);
       break;
     case 17: /* snmpInSetRequests */
-      *uint_ptr = snmp_stats.insetrequests;
+      *uint_ptr = SNMP_STATS_GET(insetrequests);
       break;
     case 18: /* snmpInGetResponses */
-      *uint_ptr = snmp_stats.ingetresponses;
+      *uint_ptr = SNMP_STATS_GET(ingetresponses);
       break;
     case 19: /* snmpInTraps */
-      *uint_ptr = snmp_stats.intraps;
+      *uint_ptr = SNMP_STATS_GET(intraps);
       break;
     case 20: /* snmpOutTooBigs */
-      *uint_ptr = snmp_stats.outtoobigs;
+      *uint_ptr = SNMP_STATS_GET(outtoobigs);
       break;
     case 21: /* snmpOutNoSuchNames */
-      *uint_ptr = snmp_stats.outnosuchnames;
+      *uint_ptr = SNMP_STATS_GET(outnosuchnames);
       break;
     case 22: /* snmpOutBadValues */
-      *uint_ptr = snmp_stats.outbadvalues;
+      *uint_ptr = SNMP_STATS_GET(outbadvalues);
       break;
     case 24: /* snmpOutGenErrs */
-      *uint_ptr = snmp_stats.outgenerrs;
+      *uint_ptr = SNMP_STATS_GET(outgenerrs);
       break;
     case 25: /* snmpOutGetRequests */
-      *uint_ptr = snmp_stats.outgetrequests;
+      *uint_ptr = SNMP_STATS_GET(outgetrequests);
       break;
     case 26: /* snmpOutGetNexts */
-      *uint_ptr = snmp_stats.outgetnexts;
+      *uint_ptr = SNMP_STATS_GET(outgetnexts);
       break;
     case 27: /* snmpOutSetRequests */
-      *uint_ptr = snmp_stats.outsetrequests;
+      *uint_ptr = SNMP_STATS_GET(outsetrequests);
       break;
     case 28: /* snmpOutGetResponses */
-      *uint_ptr = snmp_stats.outgetresponses;
+      *uint_ptr = SNMP_STATS_GET(outgetresponses);
       break;
     case 29: /* snmpOutTraps */
-      *uint_ptr = snmp_stats.outtraps;
+      *uint_ptr = SNMP_STATS_GET(outtraps);
       break;
     case 30: /* snmpEnableAuthenTraps */
       if (snmp_get_auth_traps_enabled() == SNMP_AUTH_TRAPS_DISABLED) {
@@ -190,36 +190,36 @@ snmp_set_value(const struct snmp_scalar_array_node_def *node, u16_t len, void *v
 
 /* the following nodes access variables in SNMP stack (snmp_stats) from SNMP worker thread -> OK, no sync needed */
 static const struct snmp_scalar_array_node_def snmp_nodes[] = {
-  { 1, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY},  /* snmpInPkts */
-  { 2, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY},  /* snmpOutPkts */
-  { 3, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY},  /* snmpInBadVersions */
-  { 4, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY},  /* snmpInBadCommunityNames */
-  { 5, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY},  /* snmpInBadCommunityUses */
-  { 6, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY},  /* snmpInASNParseErrs */
-  { 8, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY},  /* snmpInTooBigs */
-  { 9, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY},  /* snmpInNoSuchNames */
-  {10, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY},  /* snmpInBadValues */
-  {11, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY},  /* snmpInReadOnlys */
-  {12, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY},  /* snmpInGenErrs */
-  {13, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY},  /* snmpInTotalReqVars */
-  {14, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY},  /* snmpInTotalSetVars */
-  {15, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY},  /* snmpInGetRequests */
-  {16, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY},  /* snmpInGetNexts */
-  {17, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY},  /* snmpInSetRequests */
-  {18, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY},  /* snmpInGetResponses */
-  {19, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY},  /* snmpInTraps */
-  {20, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY},  /* snmpOutTooBigs */
-  {21, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY},  /* snmpOutNoSuchNames */
-  {22, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY},  /* snmpOutBadValues */
-  {24, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY},  /* snmpOutGenErrs */
-  {25, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY},  /* snmpOutGetRequests */
-  {26, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY},  /* snmpOutGetNexts */
-  {27, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY},  /* snmpOutSetRequests */
-  {28, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY},  /* snmpOutGetResponses */
-  {29, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY},  /* snmpOutTraps */
-  {30, SNMP_ASN1_TYPE_INTEGER, SNMP_NODE_INSTANCE_READ_WRITE}, /* snmpEnableAuthenTraps */
-  {31, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY},  /* snmpSilentDrops */
-  {32, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY}   /* snmpProxyDrops */
+  { 1, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY SNMP_NODE_CACHE_TTL(0)},  /* snmpInPkts */
+  { 2, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY SNMP_NODE_CACHE_TTL(0)},  /* snmpOutPkts */
+  { 3, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY SNMP_NODE_CACHE_TTL(0)},  /* snmpInBadVersions */
+  { 4, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY SNMP_NODE_CACHE_TTL(0)},  /* snmpInBadCommunityNames */
+  { 5, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY SNMP_NODE_CACHE_TTL(0)},  /* snmpInBadCommunityUses */
+  { 6, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY SNMP_NODE_CACHE_TTL(0)},  /* snmpInASNParseErrs */
+  { 8, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY SNMP_NODE_CACHE_TTL(0)},  /* snmpInTooBigs */
+  { 9, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY SNMP_NODE_CACHE_TTL(0)},  /* snmpInNoSuchNames */
+  {10, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY SNMP_NODE_CACHE_TTL(0)},  /* snmpInBadValues */
+  {11, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY SNMP_NODE_CACHE_TTL(0)},  /* snmpInReadOnlys */
+  {12, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY SNMP_NODE_CACHE_TTL(0)},  /* snmpInGenErrs */
+  {13, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY SNMP_NODE_CACHE_TTL(0)},  /* snmpInTotalReqVars */
+  {14, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY SNMP_NODE_CACHE_TTL(0)},  /* snmpInTotalSetVars */
+  {15, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY SNMP_NODE_CACHE_TTL(0)},  /* snmpInGetRequests */
+  {16, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY SNMP_NODE_CACHE_TTL(0)},  /* snmpInGetNexts */
+  {17, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY SNMP_NODE_CACHE_TTL(0)},  /* snmpInSetRequests */
+  {18, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY SNMP_NODE_CACHE_TTL(0)},  /* snmpInGetResponses */
+  {19, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY SNMP_NODE_CACHE_TTL(0)},  /* snmpInTraps */
+  {20, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY SNMP_NODE_CACHE_TTL(0)},  /* snmpOutTooBigs */
+  {21, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY SNMP_NODE_CACHE_TTL(0)},  /* snmpOutNoSuchNames */
+  {22, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY SNMP_NODE_CACHE_TTL(0)},  /* snmpOutBadValues */
+  {24, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY SNMP_NODE_CACHE_TTL(0)},  /* snmpOutGenErrs */
+  {25, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY SNMP_NODE_CACHE_TTL(0)},  /* snmpOutGetRequests */
+  {26, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY SNMP_NODE_CACHE_TTL(0)},  /* snmpOutGetNexts */
+  {27, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY SNMP_NODE_CACHE_TTL(0)},  /* snmpOutSetRequests */
+  {28, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY SNMP_NODE_CACHE_TTL(0)},  /* snmpOutGetResponses */
+  {29, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY SNMP_NODE_CACHE_TTL(0)},  /* snmpOutTraps */
+  {30, SNMP_ASN1_TYPE_INTEGER, SNMP_NODE_INSTANCE_READ_WRITE SNMP_NODE_CACHE_TTL(0)}, /* snmpEnableAuthenTraps */
+  {31, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY SNMP_NODE_CACHE_TTL(0)},  /* snmpSilentDrops */
+  {32, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY SNMP_NODE_CACHE_TTL(0)}   /* snmpProxyDrops */
 };
 
 const struct snmp_scalar_array_node snmp_mib2_snmp_root = SNMP_SCALAR_CREATE_ARRAY_NODE(11, snmp_nodes, snmp_get_value, snmp_set_test, snmp_set_value);
@@ -304,6 +304,53 @@ tcp_ConnTable_get_next_cell_instance_and_value(const u32_t *column, struct snmp_
   return SNMP_ERR_NOSUCHINSTANCE;
 }
 
+#if SNMP_TABLE_NEXT_CELLS > 0
+static snmp_err_t
+tcp_ConnTable_get_next_cells(const u32_t *column, const struct snmp_obj_id *row_oid, struct snmp_next_cells *cells)
+{
+  u8_t i;
+  struct tcp_pcb *pcb;
+
+  /* init cells to collect the next rows */
+  snmp_next_cells_init(cells, row_oid->id, row_oid->len);
+
+  /* iterate over all possible OIDs to find the next ones */
+  for (i = 0; i < LWIP_ARRAYSIZE(tcp_pcb_lists); i++) {
+    pcb = *tcp_pcb_lists[i];
+    while (pcb != NULL) {
+      u32_t test_oid[LWIP_ARRAYSIZE(tcp_ConnTable_oid_ranges)];
+
+      if (IP_IS_V4_VAL(pcb->local_ip)) {
+        snmp_ip4_to_oid(ip_2_ip4(&pcb->local_ip), &test_oid[0]);
+        test_oid[4] = pcb->local_port;
+
+        /* PCBs in state LISTEN are not connected and have no remote_ip or remote_port */
+        if (pcb->state == LISTEN) {
+          snmp_ip4_to_oid(IP4_ADDR_ANY4, &test_oid[5]);
+          test_oid[9] = 0;
+          snmp_next_cells_check(cells, test_oid, LWIP_ARRAYSIZE(tcp_ConnTable_oid_ranges), pcb);
+        } else if (!IP_IS_V6_VAL(pcb->remote_ip)) { /* should never happen */
+          snmp_ip4_to_oid(ip_2_ip4(&pcb->remote_ip), &test_oid[5]);
+          test_oid[9] = pcb->remote_port;
+          snmp_next_cells_check(cells, test_oid, LWIP_ARRAYSIZE(tcp_ConnTable_oid_ranges), pcb);
+        }
+      }
+
+      pcb = pcb->next;
+    }
+  }
+
+  /* fill in object properties, replacing the PCB references */
+  for (i = 0; i < cells->count; i++) {
+    if (tcp_ConnTable_get_cell_value_core((struct tcp_pcb *)cells->value[i].ptr, column, &cells->value[i], &cells->value_len[i]) != SNMP_ERR_NOERROR) {
+      return SNMP_ERR_NOSUCHINSTANCE;
+    }
+  }
+
+  return SNMP_ERR_NOERROR;
+}
+#endif /* SNMP_TABLE_NEXT_CELLS > 0 */
+
 #endif /* LWIP_IPV4 */
 
 /* --- tcpConnectionTable --- */
@@ -418,6 +465,49 @@ tcp_ConnectionTable_get_next_cell_instance_and_value(const u32_t *column, struct
   }
 }
 
+#if SNMP_TABLE_NEXT_CELLS > 0
+static snmp_err_t
+tcp_ConnectionTable_get_next_cells(const u32_t *column, const struct snmp_obj_id *row_oid, struct snmp_next_cells *cells)
+{
+  struct tcp_pcb *pcb;
+  u8_t i;
+  struct tcp_pcb **const tcp_pcb_nonlisten_lists[] = {&tcp_bound_pcbs, &tcp_active_pcbs, &tcp_tw_pcbs};
+
+  /* init cells to collect the next rows */
+  snmp_next_cells_init(cells, row_oid->id, row_oid->len);
+
+  /* iterate over all possible OIDs to find the next ones */
+  for (i = 0; i < LWIP_ARRAYSIZE(tcp_pcb_nonlisten_lists); i++) {
+    pcb = *tcp_pcb_nonlisten_lists[i];
+
+    while (pcb != NULL) {
+      u8_t idx = 0;
+      u32_t test_oid[38];
+
+      /* tcpConnectionLocalAddressType + tcpConnectionLocalAddress + tcpConnectionLocalPort */
+      idx += snmp_ip_port_to_oid(&pcb->local_ip, pcb->local_port, &test_oid[idx]);
+
+      /* tcpConnectionRemAddressType + tcpConnectionRemAddress + tcpConnectionRemPort */
+      idx += snmp_ip_port_to_oid(&pcb->remote_ip, pcb->remote_port, &test_oid[idx]);
+
+      /* check generated OID: is it a candidate for the next ones? */
+      snmp_next_cells_check(cells, test_oid, idx, pcb);
+
+      pcb = pcb->next;
+    }
+  }
+
+  /* fill in object properties, replacing the PCB references */
+  for (i = 0; i < cells->count; i++) {
+    if (tcp_ConnectionTable_get_cell_value_core(column, (struct tcp_pcb *)cells->value[i].ptr, &cells->value[i]) != SNMP_ERR_NOERROR) {
+      return SNMP_ERR_NOSUCHINSTANCE;
+    }
+  }
+
+  return SNMP_ERR_NOERROR;
+}
+#endif /* SNMP_TABLE_NEXT_CELLS > 0 */
+
 /* --- tcpListenerTable --- */
 
 static snmp_err_t
@@ -505,6 +595,42 @@ tcp_ListenerTable_get_next_cell_instance_and_value(const u32_t *column, struct s
   }
 }
 
+#if SNMP_TABLE_NEXT_CELLS > 0
+static snmp_err_t
+tcp_ListenerTable_get_next_cells(const u32_t *column, const struct snmp_obj_id *row_oid, struct snmp_next_cells *cells)
+{
+  struct tcp_pcb_listen *pcb;
+  u8_t i;
+
+  /* init cells to collect the next rows */
+  snmp_next_cells_init(cells, row_oid->id, row_oid->len);
+
+  /* iterate over all possible OIDs to find the next ones */
+  pcb = tcp_listen_pcbs.listen_pcbs;
+  while (pcb != NULL) {
+    u8_t idx = 0;
+    u32_t test_oid[19];
+
+    /* tcpListenerLocalAddressType + tcpListenerLocalAddress + tcpListenerLocalPort */
+    idx += snmp_ip_port_to_oid(&pcb->local_ip, pcb->local_port, &test_oid[idx]);
+
+    /* check generated OID: is it a candidate for the next ones? */
+    snmp_next_cells_check(cells, test_oid, idx, NULL);
+
+    pcb = pcb->next;
+  }
+
+  /* fill in object properties */
+  for (i = 0; i < cells->count; i++) {
+    if (tcp_ListenerTable_get_cell_value_core(column, &cells->value[i]) != SNMP_ERR_NOERROR) {
+      return SNMP_ERR_NOSUCHINSTANCE;
+    }
+  }
+
+  return SNMP_ERR_NOERROR;
+}
+#endif /* SNMP_TABLE_NEXT_CELLS > 0 */
+
 static const struct snmp_scalar_node tcp_RtoAlgorithm  = SNMP_SCALAR_CREATE_NODE_READONLY(1, SNMP_ASN1_TYPE_INTEGER, tcp_get_value);
 static const struct snmp_scalar_node tcp_RtoMin        = SNMP_SCALAR_CREATE_NODE_READONLY(2, SNMP_ASN1_TYPE_INTEGER, tcp_get_value);
 static const struct snmp_scalar_node tcp_RtoMax        = SNMP_SCALAR_CREATE_NODE_READONLY(3, SNMP_ASN1_TYPE_INTEGER, tcp_get_value);
@@ -526,31 +652,31 @@ static const struct snmp_scalar_node tcp_HCOutSegs     = SNMP_SCALAR_CREATE_NODE
 
 #if LWIP_IPV4
 static const struct snmp_table_simple_col_def tcp_ConnTable_columns[] = {
-  {  1, SNMP_ASN1_TYPE_INTEGER, SNMP_VARIANT_VALUE_TYPE_U32 }, /* tcpConnState */
-  {  2, SNMP_ASN1_TYPE_IPADDR,  SNMP_VARIANT_VALUE_TYPE_U32 }, /* tcpConnLocalAddress */
-  {  3, SNMP_ASN1_TYPE_INTEGER, SNMP_VARIANT_VALUE_TYPE_U32 }, /* tcpConnLocalPort */
-  {  4, SNMP_ASN1_TYPE_IPADDR,  SNMP_VARIANT_VALUE_TYPE_U32 }, /* tcpConnRemAddress */
-  {  5, SNMP_ASN1_TYPE_INTEGER, SNMP_VARIANT_VALUE_TYPE_U32 }  /* tcpConnRemPort */
+  {  1, SNMP_ASN1_TYPE_INTEGER, SNMP_VARIANT_VALUE_TYPE_U32 SNMP_NODE_CACHE_TTL(0) }, /* tcpConnState */
+  {  2, SNMP_ASN1_TYPE_IPADDR,  SNMP_VARIANT_VALUE_TYPE_U32 SNMP_NODE_CACHE_TTL(0) }, /* tcpConnLocalAddress */
+  {  3, SNMP_ASN1_TYPE_INTEGER, SNMP_VARIANT_VALUE_TYPE_U32 SNMP_NODE_CACHE_TTL(0) }, /* tcpConnLocalPort */
+  {  4, SNMP_ASN1_TYPE_IPADDR,  SNMP_VARIANT_VALUE_TYPE_U32 SNMP_NODE_CACHE_TTL(0) }, /* tcpConnRemAddress */
+  {  5, SNMP_ASN1_TYPE_INTEGER, SNMP_VARIANT_VALUE_TYPE_U32 SNMP_NODE_CACHE_TTL(0) }  /* tcpConnRemPort */
 };
 
-static const struct snmp_table_simple_node tcp_ConnTable = SNMP_TABLE_CREATE_SIMPLE(13, tcp_ConnTable_columns, tcp_ConnTable_get_cell_value, tcp_ConnTable_get_next_cell_instance_and_value);
+static const struct snmp_table_simple_node tcp_ConnTable = SNMP_TABLE_CREATE_SIMPLE_NEXT_CELLS(13, tcp_ConnTable_columns, tcp_ConnTable_get_cell_value, tcp_ConnTable_get_next_cell_instance_and_value, tcp_ConnTable_get_next_cells);
 #endif /* LWIP_IPV4 */
 
 static const struct snmp_table_simple_col_def tcp_ConnectionTable_columns[] = {
   /* all items except tcpConnectionState and tcpConnectionProcess are declared as not-accessible */
-  { 7, SNMP_ASN1_TYPE_INTEGER,    SNMP_VARIANT_VALUE_TYPE_U32 }, /* tcpConnectionState */
-  { 8, SNMP_ASN1_TYPE_UNSIGNED32, SNMP_VARIANT_VALUE_TYPE_U32 }  /* tcpConnectionProcess */
+  { 7, SNMP_ASN1_TYPE_INTEGER,    SNMP_VARIANT_VALUE_TYPE_U32 SNMP_NODE_CACHE_TTL(0) }, /* tcpConnectionState */
+  { 8, SNMP_ASN1_TYPE_UNSIGNED32, SNMP_VARIANT_VALUE_TYPE_U32 SNMP_NODE_CACHE_TTL(0) }  /* tcpConnectionProcess */
 };
 
-static const struct snmp_table_simple_node tcp_ConnectionTable = SNMP_TABLE_CREATE_SIMPLE(19, tcp_ConnectionTable_columns, tcp_ConnectionTable_get_cell_value, tcp_ConnectionTable_get_next_cell_instance_and_value);
+static const struct snmp_table_simple_node tcp_ConnectionTable = SNMP_TABLE_CREATE_SIMPLE_NEXT_CELLS(19, tcp_ConnectionTable_columns, tcp_ConnectionTable_get_cell_value, tcp_ConnectionTable_get_next_cell_instance_and_value, tcp_ConnectionTable_get_next_cells);
 
 
 static const struct snmp_table_simple_col_def tcp_ListenerTable_columns[] = {
   /* all items except tcpListenerProcess are declared as not-accessible */
-  { 4, SNMP_ASN1_TYPE_UNSIGNED32, SNMP_VARIANT_VALUE_TYPE_U32 }  /* tcpListenerProcess */
+  { 4, SNMP_ASN1_TYPE_UNSIGNED32, SNMP_VARIANT_VALUE_TYPE_U32 SNMP_NODE_CACHE_TTL(0) }  /* tcpListenerProcess */
 };
 
-static const struct snmp_table_simple_node tcp_ListenerTable = SNMP_TABLE_CREATE_SIMPLE(20, tcp_ListenerTable_columns, tcp_ListenerTable_get_cell_value, tcp_ListenerTable_get_next_cell_instance_and_value);
+static const struct snmp_table_simple_node tcp_ListenerTable = SNMP_TABLE_CREATE_SIMPLE_NEXT_CELLS(20, tcp_ListenerTable_columns, tcp_ListenerTable_get_cell_value, tcp_ListenerTable_get_next_cell_instance_and_value, tcp_ListenerTable_get_next_cells);
 
 /* the following nodes access variables in LWIP stack from SNMP worker thread and must therefore be synced to LWIP (TCPIP) thread */
 CREATE_LWIP_SYNC_NODE( 1, tcp_RtoAlgorithm)
@@ -209,6 +209,48 @@ udp_endpointTable_get_next_cell_instance_and_value(const u32_t *column, struct s
   }
 }
 
+#if SNMP_TABLE_NEXT_CELLS > 0
+static snmp_err_t
+udp_endpointTable_get_next_cells(const u32_t *column, const struct snmp_obj_id *row_oid, struct snmp_next_cells *cells)
+{
+  struct udp_pcb *pcb;
+  u8_t i;
+
+  /* init cells to collect the next rows */
+  snmp_next_cells_init(cells, row_oid->id, row_oid->len);
+
+  /* iterate over all possible OIDs to find the next ones */
+  pcb = udp_pcbs;
+  while (pcb != NULL) {
+    u32_t test_oid[39];
+    u8_t idx = 0;
+
+    /* udpEndpointLocalAddressType + udpEndpointLocalAddress + udpEndpointLocalPort */
+    idx += snmp_ip_port_to_oid(&pcb->local_ip, pcb->local_port, &test_oid[idx]);
+
+    /* udpEndpointRemoteAddressType + udpEndpointRemoteAddress + udpEndpointRemotePort */
+    idx += snmp_ip_port_to_oid(&pcb->remote_ip, pcb->remote_port, &test_oid[idx]);
+
+    test_oid[idx] = 0; /* udpEndpointInstance */
+    idx++;
+
+    /* check generated OID: is it a candidate for the next ones? */
+    snmp_next_cells_check(cells, test_oid, idx, NULL);
+
+    pcb = pcb->next;
+  }
+
+  /* fill in object properties */
+  for (i = 0; i < cells->count; i++) {
+    if (udp_endpointTable_get_cell_value_core(column, &cells->value[i]) != SNMP_ERR_NOERROR) {
+      return SNMP_ERR_NOSUCHINSTANCE;
+    }
+  }
+
+  return SNMP_ERR_NOERROR;
+}
+#endif /* SNMP_TABLE_NEXT_CELLS > 0 */
+
 /* --- udpTable --- */
 
 #if LWIP_IPV4
@@ -312,6 +354,43 @@ udp_Table_get_next_cell_instance_and_value(const u32_t *column, struct snmp_obj_
   }
 }
 
+#if SNMP_TABLE_NEXT_CELLS > 0
+static snmp_err_t
+udp_Table_get_next_cells(const u32_t *column, const struct snmp_obj_id *row_oid, struct snmp_next_cells *cells)
+{
+  struct udp_pcb *pcb;
+  u8_t i;
+
+  /* init cells to collect the next rows */
+  snmp_next_cells_init(cells, row_oid->id, row_oid->len);
+
+  /* iterate over all possible OIDs to find the next ones */
+  pcb = udp_pcbs;
+  while (pcb != NULL) {
+    u32_t test_oid[LWIP_ARRAYSIZE(udp_Table_oid_ranges)];
+
+    if (IP_IS_V4_VAL(pcb->local_ip)) {
+      snmp_ip4_to_oid(ip_2_ip4(&pcb->local_ip), &test_oid[0]);
+      test_oid[4] = pcb->local_port;
+
+      /* check generated OID: is it a candidate for the next ones? */
+      snmp_next_cells_check(cells, test_oid, LWIP_ARRAYSIZE(udp_Table_oid_ranges), pcb);
+    }
+
+    pcb = pcb->next;
+  }
+
+  /* fill in object properties, replacing the PCB references */
+  for (i = 0; i < cells->count; i++) {
+    if (udp_Table_get_cell_value_core((struct udp_pcb *)cells->value[i].ptr, column, &cells->value[i], &cells->value_len[i]) != SNMP_ERR_NOERROR) {
+      return SNMP_ERR_NOSUCHINSTANCE;
+    }
+  }
+
+  return SNMP_ERR_NOERROR;
+}
+#endif /* SNMP_TABLE_NEXT_CELLS > 0 */
+
 #endif /* LWIP_IPV4 */
 
 static const struct snmp_scalar_node udp_inDatagrams    = SNMP_SCALAR_CREATE_NODE_READONLY(1, SNMP_ASN1_TYPE_COUNTER,   udp_get_value);
@@ -325,18 +404,18 @@ static const struct snmp_scalar_node udp_HCOutDatagrams = SNMP_SCALAR_CREATE_NOD
 
 #if LWIP_IPV4
 static const struct snmp_table_simple_col_def udp_Table_columns[] = {
-  { 1, SNMP_ASN1_TYPE_IPADDR,  SNMP_VARIANT_VALUE_TYPE_U32 }, /* udpLocalAddress */
-  { 2, SNMP_ASN1_TYPE_INTEGER, SNMP_VARIANT_VALUE_TYPE_U32 }  /* udpLocalPort */
+  { 1, SNMP_ASN1_TYPE_IPADDR,  SNMP_VARIANT_VALUE_TYPE_U32 SNMP_NODE_CACHE_TTL(0) }, /* udpLocalAddress */
+  { 2, SNMP_ASN1_TYPE_INTEGER, SNMP_VARIANT_VALUE_TYPE_U32 SNMP_NODE_CACHE_TTL(0) }  /* udpLocalPort */
 };
-static const struct snmp_table_simple_node udp_Table = SNMP_TABLE_CREATE_SIMPLE(5, udp_Table_columns, udp_Table_get_cell_value, udp_Table_get_next_cell_instance_and_value);
+static const struct snmp_table_simple_node udp_Table = SNMP_TABLE_CREATE_SIMPLE_NEXT_CELLS(5, udp_Table_columns, udp_Table_get_cell_value, udp_Table_get_next_cell_instance_and_value, udp_Table_get_next_cells);
 #endif /* LWIP_IPV4 */
 
 static const struct snmp_table_simple_col_def udp_endpointTable_columns[] = {
   /* all items except udpEndpointProcess are declared as not-accessible */
-  { 8, SNMP_ASN1_TYPE_UNSIGNED32, SNMP_VARIANT_VALUE_TYPE_U32 }  /* udpEndpointProcess */
+  { 8, SNMP_ASN1_TYPE_UNSIGNED32, SNMP_VARIANT_VALUE_TYPE_U32 SNMP_NODE_CACHE_TTL(0) }  /* udpEndpointProcess */
 };
 
-static const struct snmp_table_simple_node udp_endpointTable = SNMP_TABLE_CREATE_SIMPLE(7, udp_endpointTable_columns, udp_endpointTable_get_cell_value, udp_endpointTable_get_next_cell_instance_and_value);
+static const struct snmp_table_simple_node udp_endpointTable = SNMP_TABLE_CREATE_SIMPLE_NEXT_CELLS(7, udp_endpointTable_columns, udp_endpointTable_get_cell_value, udp_endpointTable_get_next_cell_instance_and_value, udp_endpointTable_get_next_cells);
 
 /* the following nodes access variables in LWIP stack from SNMP worker thread and must therefore be synced to LWIP (TCPIP) thread */
 CREATE_LWIP_SYNC_NODE(1, udp_inDatagrams)
@@ -42,8 +42,12 @@
 #include "snmp_msg.h"
 #include "snmp_asn1.h"
 #include "snmp_core_priv.h"
+#if SNMP_TABLE_NEXT_CELLS > 0
+#include "lwip/apps/snmp_table.h"
+#endif
 #include "lwip/ip_addr.h"
 #include "lwip/stats.h"
+#include "lwip/sys.h"
 
 #if LWIP_SNMP_V3
 #include "lwip/apps/snmpv3.h"
@@ -55,6 +59,19 @@
 
 #include <string.h>
 
+#if SNMP_OUTBOUND_PBUF_POOL_SIZE > 0
+#if !LWIP_SUPPORT_CUSTOM_PBUF
+#error SNMP_OUTBOUND_PBUF_POOL_SIZE needs LWIP_SUPPORT_CUSTOM_PBUF
+#endif
+#endif
+
+#if (SNMP_MAX_MSG_SIZE < 484) || (SNMP_MAX_MSG_SIZE > 0xFFFF - PBUF_TRANSPORT)
+#error SNMP_MAX_MSG_SIZE must be at least 484 (RFC 3417) and fit into a pbuf
+#endif
+
+/* smallest msgMaxSize a manager may advertise (RFC 3412) */
+#define SNMP_MIN_MSG_MAX_SIZE 484
+
 #define SNMP_V3_AUTH_FLAG      0x01
 #define SNMP_V3_PRIV_FLAG      0x02
 
@@ -74,6 +91,66 @@ const char *snmp_community_trap = SNMP_COMMUNITY_TRAP;
 snmp_write_callback_fct snmp_write_callback     = NULL;
 void                   *snmp_write_callback_arg = NULL;
 
+#if SNMP_OUTBOUND_PBUF_POOL_SIZE > 0
+
+#define SNMP_OUTBOUND_PBUF_MEM_LEN (LWIP_MEM_ALIGN_SIZE(PBUF_TRANSPORT) + SNMP_MAX_MSG_SIZE)
+
+struct snmp_outbound_pbuf {
+  /* must be first member (casted from struct pbuf in free function) */
+  struct pbuf_custom pc;
+  u8_t in_use;
+  u8_t payload_mem[LWIP_MEM_ALIGN_BUFFER(SNMP_OUTBOUND_PBUF_MEM_LEN)];
+};
+
+static struct snmp_outbound_pbuf snmp_outbound_pbuf_pool[SNMP_OUTBOUND_PBUF_POOL_SIZE];
+
+static void
+snmp_outbound_pbuf_free(struct pbuf *p)
+{
+  struct snmp_outbound_pbuf *opb = (struct snmp_outbound_pbuf *)p;
+  SYS_ARCH_DECL_PROTECT(old_level);
+
+  SYS_ARCH_PROTECT(old_level);
+  opb->in_use = 0;
+  SYS_ARCH_UNPROTECT(old_level);
+}
+
+/* take response buffer from pool, fail (or fall back to lwIP heap if configured) if pool is exhausted */
+static struct pbuf *
+snmp_outbound_pbuf_alloc(struct snmp_request *request, u16_t length)
+{
+  struct snmp_outbound_pbuf *opb = NULL;
+  u8_t i;
+  SYS_ARCH_DECL_PROTECT(old_level);
+
+  SYS_ARCH_PROTECT(old_level);
+  for (i = 0; i < SNMP_OUTBOUND_PBUF_POOL_SIZE; i++) {
+    if (!snmp_outbound_pbuf_pool[i].in_use) {
+      opb = &snmp_outbound_pbuf_pool[i];
+      opb->in_use = 1;
+      break;
+    }
+  }
+  SYS_ARCH_UNPROTECT(old_level);
+
+  if (opb != NULL) {
+    SNMP_REQUEST_STATS_INC(request, outpbufpoolhits);
+    opb->pc.custom_free_function = snmp_outbound_pbuf_free;
+    return pbuf_alloced_custom(PBUF_TRANSPORT, length, PBUF_RAM, &opb->pc,
+                               LWIP_MEM_ALIGN(opb->payload_mem), SNMP_OUTBOUND_PBUF_MEM_LEN);
+  }
+
+  SNMP_REQUEST_STATS_INC(request, outpbufpoolmisses);
+#if SNMP_OUTBOUND_PBUF_HEAP_FALLBACK
+  LWIP_DEBUGF(SNMP_DEBUG, ("snmp_outbound_pbuf_alloc(): pool exhausted, allocate from heap\n"));
+  return pbuf_alloc(PBUF_TRANSPORT, length, PBUF_RAM);
+#else
+  LWIP_DEBUGF(SNMP_DEBUG, ("snmp_outbound_pbuf_alloc(): pool exhausted, response dropped\n"));
+  return NULL;
+#endif
+}
+#endif /* SNMP_OUTBOUND_PBUF_POOL_SIZE > 0 */
+
 #if LWIP_SNMP_CONFIGURE_VERSIONS
 
 static u8_t v1_enabled = 1;
@@ -155,6 +232,87 @@ snmp_v3_enable(u8_t enable)
 
 #endif
 
+#if SNMP_RESPONSE_HEADER_TEMPLATES
+/* 'Message' sequence + version + community (type and 1 length byte) + 'PDU' sequence */
+#define SNMP_RESPONSE_HEADER_COMMUNITY_OFFSET (4 + 3 + 2)
+#define SNMP_RESPONSE_HEADER_MAX_LEN          (SNMP_RESPONSE_HEADER_COMMUNITY_OFFSET + SNMP_MAX_COMMUNITY_STR_LEN + 4)
+
+/* encoded v1/v2c response header up to the request ID, lengths to be filled in by snmp_complete_outbound_frame() */
+struct snmp_response_header {
+  /* 0 if there is no template */
+  u16_t len;
+  u8_t data[SNMP_RESPONSE_HEADER_MAX_LEN];
+};
+
+/* for the read and the write community, per version */
+static struct snmp_response_header snmp_response_headers[2][SNMP_VERSION_2c + 1];
+
+static void
+snmp_response_headers_build(struct snmp_response_header *headers, const char *community)
+{
+  size_t community_len = strlen(community);
+  u8_t version;
+
+  for (version = SNMP_VERSION_1; version <= SNMP_VERSION_2c; version++) {
+    struct snmp_response_header *header = &headers[version];
+    u16_t len = 0;
+
+    header->len = 0;
+    if (community_len > 127) {
+      /* not with one length byte */
+      continue;
+    }
+
+    /* 'Message' sequence, length_len 3 as in snmp_prepare_outbound_frame() */
+    header->data[len++] = SNMP_ASN1_TYPE_SEQUENCE;
+    header->data[len++] = 0x82;
+    header->data[len++] = 0;
+    header->data[len++] = 0;
+    /* version */
+    header->data[len++] = SNMP_ASN1_TYPE_INTEGER;
+    header->data[len++] = 1;
+    header->data[len++] = version;
+    /* community */
+    header->data[len++] = SNMP_ASN1_TYPE_OCTET_STRING;
+    header->data[len++] = (u8_t)community_len;
+    MEMCPY(&header->data[len], community, community_len);
+    len += (u16_t)community_len;
+    /* 'PDU' sequence */
+    header->data[len++] = SNMP_ASN1_CLASS_CONTEXT | SNMP_ASN1_CONTENTTYPE_CONSTRUCTED | SNMP_ASN1_CONTEXT_PDU_GET_RESP;
+    header->data[len++] = 0x82;
+    header->data[len++] = 0;
+    header->data[len++] = 0;
+
+    header->len = len;
+  }
+}
+
+/* template for the response to a request, NULL if there is none */
+static const struct snmp_response_header *
+snmp_response_header_get(const struct snmp_request *request)
+{
+  u8_t i;
+
+  if ((request->version > SNMP_VERSION_2c) ||
+      (request->request_out_type != (SNMP_ASN1_CLASS_CONTEXT | SNMP_ASN1_CONTENTTYPE_CONSTRUCTED | SNMP_ASN1_CONTEXT_PDU_GET_RESP))) {
+    return NULL;
+  }
+
+  for (i = 0; i < LWIP_ARRAYSIZE(snmp_response_headers); i++) {
+    const struct snmp_response_header *header = &snmp_response_headers[i][request->version];
+
+    /* the response echoes the community of the request */
+    if ((header->len != 0) &&
+        (header->data[SNMP_RESPONSE_HEADER_COMMUNITY_OFFSET - 1] == request->community_strlen) &&
+        (memcmp(&header->data[SNMP_RESPONSE_HEADER_COMMUNITY_OFFSET], request->community, request->community_strlen) == 0)) {
+      return header;
+    }
+  }
+
+  return NULL;
+}
+#endif /* SNMP_RESPONSE_HEADER_TEMPLATES */
+
 /**
  * @ingroup snmp_core
  * Returns current SNMP community string.
@@ -180,6 +338,9 @@ snmp_set_community(const char *const community)
   LWIP_ASSERT_CORE_LOCKED();
   LWIP_ASSERT("community string is too long!", strlen(community) <= SNMP_MAX_COMMUNITY_STR_LEN);
   snmp_community = community;
+#if SNMP_RESPONSE_HEADER_TEMPLATES
+  snmp_response_headers_build(snmp_response_headers[0], community);
+#endif
 }
 
 /**
@@ -219,6 +380,9 @@ snmp_set_community_write(const char *const community)
   LWIP_ASSERT("community string must not be NULL", community != NULL);
   LWIP_ASSERT("community string is too long!", strlen(community) <= SNMP_MAX_COMMUNITY_STR_LEN);
   snmp_community_write = community;
+#if SNMP_RESPONSE_HEADER_TEMPLATES
+  snmp_response_headers_build(snmp_response_headers[1], community);
+#endif
 }
 
 /**
@@ -249,6 +413,678 @@ snmp_set_write_callback(snmp_write_callback_fct write_callback, void *callback_a
   snmp_write_callback_arg = callback_arg;
 }
 
+#if SNMP_WORKER_THREADS > 1
+/* test and commit phases of one SET request must not interleave with another */
+static sys_mutex_t snmp_set_mutex;
+
+/**
+ * @ingroup snmp_core
+ * Prepares the message engine for concurrent snmp_receive() calls.
+ * Called once by the transport before the first request when SNMP_WORKER_THREADS > 1.
+ */
+void
+snmp_msg_init(void)
+{
+  err_t err = sys_mutex_new(&snmp_set_mutex);
+  LWIP_UNUSED_ARG(err); /* in case of LWIP_NOASSERT */
+  LWIP_ASSERT("Failed to set up mutex", err == ERR_OK);
+}
+#endif
+
+#if SNMP_PROFILE
+static void
+snmp_profile_add(struct snmp_request *request, u8_t phase, u32_t ticks)
+{
+  request->profile_ticks[phase] += ticks;
+  request->profile_phases |= (u16_t)(1U << phase);
+}
+
+#define SNMP_PROFILE_END(request, phase, start) snmp_profile_add((request), (phase), SNMP_PROFILE_ELAPSED(start))
+/* moves the thread sync waits of a node instance to the request */
+#define SNMP_PROFILE_SYNC(request, instance) do { \
+    if ((instance)->sync_ticks != 0) { \
+      snmp_profile_add((request), SNMP_PROFILE_THREADSYNC, (instance)->sync_ticks); \
+      (instance)->sync_ticks = 0; \
+    } \
+  } while (0)
+
+/* counts every phase the request went through in the histograms of its PDU type */
+static void
+snmp_profile_commit(struct snmp_request *request)
+{
+  u8_t pdu = SNMP_PROFILE_PDU_OTHER;
+  u8_t phase;
+  SYS_ARCH_DECL_PROTECT(old_level);
+
+  if (request->request_out_type == (SNMP_ASN1_CLASS_CONTEXT | SNMP_ASN1_CONTENTTYPE_CONSTRUCTED | SNMP_ASN1_CONTEXT_PDU_GET_RESP)) {
+    switch (request->request_type) {
+      case SNMP_ASN1_CONTEXT_PDU_GET_REQ:
+        pdu = SNMP_PROFILE_PDU_GET;
+        break;
+      case SNMP_ASN1_CONTEXT_PDU_GET_NEXT_REQ:
+        pdu = SNMP_PROFILE_PDU_GETNEXT;
+        break;
+      case SNMP_ASN1_CONTEXT_PDU_GET_BULK_REQ:
+        pdu = SNMP_PROFILE_PDU_GETBULK;
+        break;
+      case SNMP_ASN1_CONTEXT_PDU_SET_REQ:
+        pdu = SNMP_PROFILE_PDU_SET;
+        break;
+      default:
+        break;
+    }
+  }
+
+  /* shared by all workers */
+  SYS_ARCH_PROTECT(old_level);
+  for (phase = 0; phase < SNMP_PROFILE_PHASES; phase++) {
+    if (request->profile_phases & (1U << phase)) {
+      u32_t ticks = request->profile_ticks[phase];
+      u8_t bucket = 0;
+
+      while ((ticks > 1) && (bucket < (SNMP_PROFILE_BUCKETS - 1))) {
+        ticks >>= 1;
+        bucket++;
+      }
+      snmp_profile[pdu][phase][bucket]++;
+    }
+  }
+  SYS_ARCH_UNPROTECT(old_level);
+}
+#else
+#define SNMP_PROFILE_END(request, phase, start)
+#define SNMP_PROFILE_SYNC(request, instance)
+#endif
+
+#if SNMP_MIB_REGISTRY_SIZE > 0
+#define SNMP_REQUEST_MIB_REGISTRY(request) ((request)->mib_registry)
+
+/* reader slot pinning the MIBs of the request, the one of its statistics shard */
+static u8_t
+snmp_request_mib_registry_reader(const struct snmp_request *request)
+{
+#if SNMP_WORKER_THREADS > 1
+  if (request->stats == NULL) {
+    return SNMP_MIB_REGISTRY_SHARED_READER;
+  }
+  return (u8_t)(request->stats - snmp_stats_shards);
+#else
+  LWIP_UNUSED_ARG(request);
+  return 0;
+#endif
+}
+#else
+#define SNMP_REQUEST_MIB_REGISTRY(request) NULL
+#endif
+
+/* request processed (or dropped), account it and release what it held */
+static void
+snmp_request_done(struct snmp_request *request)
+{
+#if SNMP_PROFILE
+  snmp_profile_commit(request);
+#endif
+#if SNMP_MIB_REGISTRY_SIZE > 0
+  snmp_mib_registry_release(snmp_request_mib_registry_reader(request), request->mib_registry);
+#endif
+#if SNMP_WORKER_THREADS > 1
+  if (request->stats != NULL) {
+    snmp_stats_shard_free(request->stats);
+  }
+#else
+  LWIP_UNUSED_ARG(request);
+#endif
+}
+
+static err_t
+snmp_msg_append_varbind(struct snmp_request *request, struct snmp_varbind *vb)
+{
+  err_t err;
+  SNMP_PROFILE_DECL(start)
+
+  SNMP_PROFILE_BEGIN(start);
+  err = snmp_append_outbound_varbind(&request->outbound_pbuf_stream, vb);
+  SNMP_PROFILE_END(request, SNMP_PROFILE_ENCODE, start);
+
+  return err;
+}
+
+#if SNMP_RESPONSE_CACHE_SIZE > 0
+
+struct snmp_response_cache_entry {
+  /* cached response, NULL if entry is unused */
+  struct pbuf *response;
+  ip_addr_t source_ip;
+  u16_t source_port;
+  u8_t version;
+  u8_t request_type;
+  s32_t request_id;
+  u8_t community[SNMP_MAX_COMMUNITY_STR_LEN];
+  u16_t community_strlen;
+#if LWIP_SNMP_V3
+  s32_t msg_id;
+  u8_t msg_user_name[SNMP_V3_MAX_USER_LENGTH];
+  u8_t msg_user_name_len;
+#endif
+  /* sys_now() when response was cached */
+  u32_t cached;
+  /* sys_now() when response was cached or last replayed */
+  u32_t used;
+};
+
+static struct snmp_response_cache_entry snmp_response_cache[SNMP_RESPONSE_CACHE_SIZE];
+
+static u8_t
+snmp_response_cache_match(const struct snmp_response_cache_entry *entry, const struct snmp_request *request)
+{
+#if LWIP_SNMP_V3
+  if ((request->version == SNMP_VERSION_3) &&
+      ((entry->msg_id != request->msg_id) ||
+       (entry->msg_user_name_len != request->msg_user_name_len) ||
+       (memcmp(entry->msg_user_name, request->msg_user_name, request->msg_user_name_len) != 0))) {
+    return 0;
+  }
+#endif
+
+  return (entry->request_id == request->request_id) &&
+         (entry->source_port == request->source_port) &&
+         (entry->version == request->version) &&
+         (entry->request_type == request->request_type) &&
+         (entry->community_strlen == request->community_strlen) &&
+         ip_addr_cmp(&entry->source_ip, request->source_ip) &&
+         (memcmp(entry->community, request->community, request->community_strlen) == 0);
+}
+
+/* detach all expired responses, must be called with SYS_ARCH_PROTECT, pbufs are returned for freeing outside */
+static u8_t
+snmp_response_cache_expire(u32_t now, struct pbuf **expired)
+{
+  u8_t i, num_expired = 0;
+
+  for (i = 0; i < SNMP_RESPONSE_CACHE_SIZE; i++) {
+    if ((snmp_response_cache[i].response != NULL) &&
+        ((u32_t)(now - snmp_response_cache[i].cached) >= SNMP_RESPONSE_CACHE_TIMEOUT)) {
+      expired[num_expired++] = snmp_response_cache[i].response;
+      snmp_response_cache[i].response = NULL;
+    }
+  }
+
+  return num_expired;
+}
+
+/* find cached response for retransmitted request, returned referenced (or NULL) */
+static struct pbuf *
+snmp_response_cache_lookup(struct snmp_request *request)
+{
+  struct pbuf *expired[SNMP_RESPONSE_CACHE_SIZE];
+  struct pbuf *response = NULL;
+  u32_t now = sys_now();
+  u8_t i, num_expired;
+  SYS_ARCH_DECL_PROTECT(old_level);
+
+  SYS_ARCH_PROTECT(old_level);
+  num_expired = snmp_response_cache_expire(now, expired);
+  for (i = 0; i < SNMP_RESPONSE_CACHE_SIZE; i++) {
+    if ((snmp_response_cache[i].response != NULL) &&
+        snmp_response_cache_match(&snmp_response_cache[i], request)) {
+      response = snmp_response_cache[i].response;
+      /* keep response alive while sending even if evicted meanwhile */
+      pbuf_ref(response);
+      snmp_response_cache[i].used = now;
+      break;
+    }
+  }
+  SYS_ARCH_UNPROTECT(old_level);
+
+  for (i = 0; i < num_expired; i++) {
+    pbuf_free(expired[i]);
+  }
+
+  return response;
+}
+
+/* answer retransmitted request with response from snmp_response_cache_lookup() */
+static void
+snmp_response_cache_replay(struct snmp_request *request, struct pbuf *response)
+{
+  SNMP_PROFILE_DECL(start)
+
+  LWIP_DEBUGF(SNMP_DEBUG, ("snmp_response_cache_replay(): answer request %"S32_F" from cache\n", request->request_id));
+  SNMP_REQUEST_STATS_INC(request, inresponsecachehits);
+  SNMP_REQUEST_STATS_INC(request, outgetresponses);
+  SNMP_REQUEST_STATS_INC(request, outpkts);
+  SNMP_PROFILE_BEGIN(start);
+  snmp_sendto(request->handle, response, request->source_ip, request->source_port);
+  SNMP_PROFILE_END(request, SNMP_PROFILE_SENDTO, start);
+  pbuf_free(response);
+}
+
+/* keep a copy of the response sent for this request, evict least recently used if full */
+static void
+snmp_response_cache_insert(struct snmp_request *request)
+{
+  struct pbuf *expired[SNMP_RESPONSE_CACHE_SIZE];
+  struct pbuf *evicted = NULL;
+  struct pbuf *response;
+  struct snmp_response_cache_entry *entry = NULL;
+  u32_t now = sys_now();
+  u8_t i, num_expired;
+  SYS_ARCH_DECL_PROTECT(old_level);
+
+#if LWIP_SNMP_V3
+  if (request->request_out_type == (SNMP_ASN1_CLASS_CONTEXT | SNMP_ASN1_CONTENTTYPE_CONSTRUCTED | SNMP_ASN1_CONTEXT_PDU_REPORT)) {
+    /* reports depend on engine state (discovery, time window), never replay them */
+    return;
+  }
+#endif
+
+  /* copy, so the outbound pbuf (possibly from preallocated pool) is released as usual */
+  response = pbuf_clone(PBUF_TRANSPORT, PBUF_RAM, request->outbound_pbuf);
+  if (response == NULL) {
+    return;
+  }
+
+  SYS_ARCH_PROTECT(old_level);
+  num_expired = snmp_response_cache_expire(now, expired);
+  for (i = 0; i < SNMP_RESPONSE_CACHE_SIZE; i++) {
+    if (snmp_response_cache[i].response == NULL) {
+      entry = &snmp_response_cache[i];
+      break;
+    }
+    if ((entry == NULL) || ((u32_t)(now - snmp_response_cache[i].used) > (u32_t)(now - entry->used))) {
+      entry = &snmp_response_cache[i];
+    }
+  }
+
+  evicted = entry->response;
+  entry->response = response;
+  ip_addr_copy(entry->source_ip, *request->source_ip);
+  entry->source_port = request->source_port;
+  entry->version = request->version;
+  entry->request_type = request->request_type;
+  entry->request_id = request->request_id;
+  MEMCPY(entry->community, request->community, request->community_strlen);
+  entry->community_strlen = request->community_strlen;
+#if LWIP_SNMP_V3
+  entry->msg_id = request->msg_id;
+  MEMCPY(entry->msg_user_name, request->msg_user_name, request->msg_user_name_len);
+  entry->msg_user_name_len = request->msg_user_name_len;
+#endif
+  entry->cached = now;
+  entry->used = now;
+  SYS_ARCH_UNPROTECT(old_level);
+
+  for (i = 0; i < num_expired; i++) {
+    pbuf_free(expired[i]);
+  }
+  if (evicted != NULL) {
+    pbuf_free(evicted);
+  }
+}
+#endif /* SNMP_RESPONSE_CACHE_SIZE > 0 */
+
+#if SNMP_RATE_LIMIT_SOURCES > 0
+#if SNMP_RATE_LIMIT_SOURCES >= 0xFF
+#error SNMP_RATE_LIMIT_SOURCES must be less than 255
+#endif
+
+/* tokens are counted in 1/1000 request, so refill is SNMP_RATE_LIMIT_RATE per millisecond */
+#define SNMP_RATE_LIMIT_TOKENS_PER_REQUEST 1000
+#define SNMP_RATE_LIMIT_TOKENS_MAX         ((u32_t)SNMP_RATE_LIMIT_BURST * SNMP_RATE_LIMIT_TOKENS_PER_REQUEST)
+#define SNMP_RATE_LIMIT_NONE               0xFF
+
+struct snmp_rate_limit_entry {
+  ip_addr_t source_ip;
+  u32_t tokens;
+  /* sys_now() of last refill, which is also when the source was last seen */
+  u32_t last;
+  /* next entry in the same hash chain */
+  u8_t next;
+  u8_t in_use;
+};
+
+static struct snmp_rate_limit_entry snmp_rate_limit_table[SNMP_RATE_LIMIT_SOURCES];
+/* hash chain heads, SNMP_RATE_LIMIT_NONE terminated */
+static u8_t snmp_rate_limit_buckets[SNMP_RATE_LIMIT_SOURCES];
+static u8_t snmp_rate_limit_initialized;
+
+static u8_t
+snmp_rate_limit_hash(const ip_addr_t *ip)
+{
+  u32_t h;
+
+#if LWIP_IPV6
+  if (IP_IS_V6(ip)) {
+    const u32_t *addr = ip_2_ip6(ip)->addr;
+    h = addr[0] ^ addr[1] ^ addr[2] ^ addr[3];
+  } else
+#endif
+  {
+#if LWIP_IPV4
+    h = ip_2_ip4(ip)->addr;
+#else
+    h = 0;
+#endif
+  }
+
+  /* Fibonacci hashing, upper bits are well mixed */
+  return (u8_t)(((h * 2654435761UL) >> 16) % SNMP_RATE_LIMIT_SOURCES);
+}
+
+static void
+snmp_rate_limit_unlink(u8_t idx)
+{
+  u8_t *link = &snmp_rate_limit_buckets[snmp_rate_limit_hash(&snmp_rate_limit_table[idx].source_ip)];
+
+  while (*link != idx) {
+    link = &snmp_rate_limit_table[*link].next;
+  }
+  *link = snmp_rate_limit_table[idx].next;
+}
+
+/**
+ * @ingroup snmp_core
+ * Takes one token from the bucket of the request source.
+ * Called by the transport for every received request before snmp_receive().
+ * @param source_ip request source IP
+ * @return 1 if the request is to be processed, 0 if it is to be dropped unparsed
+ */
+u8_t
+snmp_rate_limit_admit(const ip_addr_t *source_ip)
+{
+  struct snmp_rate_limit_entry *entry;
+  u32_t now = sys_now();
+  u32_t elapsed;
+  u8_t bucket = snmp_rate_limit_hash(source_ip);
+  u8_t idx, admit, evicted = 0;
+  SYS_ARCH_DECL_PROTECT(old_level);
+
+  SYS_ARCH_PROTECT(old_level);
+
+  if (!snmp_rate_limit_initialized) {
+    memset(snmp_rate_limit_buckets, SNMP_RATE_LIMIT_NONE, sizeof(snmp_rate_limit_buckets));
+    snmp_rate_limit_initialized = 1;
+  }
+
+  for (idx = snmp_rate_limit_buckets[bucket]; idx != SNMP_RATE_LIMIT_NONE; idx = snmp_rate_limit_table[idx].next) {
+    if (ip_addr_cmp(&snmp_rate_limit_table[idx].source_ip, source_ip)) {
+      break;
+    }
+  }
+
+  if (idx == SNMP_RATE_LIMIT_NONE) {
+    /* new source, take a free entry or evict the least recently seen one */
+    u8_t i;
+    for (i = 0; i < SNMP_RATE_LIMIT_SOURCES; i++) {
+      if (!snmp_rate_limit_table[i].in_use) {
+        idx = i;
+        break;
+      }
+      if ((idx == SNMP_RATE_LIMIT_NONE) ||
+          ((u32_t)(now - snmp_rate_limit_table[i].last) > (u32_t)(now - snmp_rate_limit_table[idx].last))) {
+        idx = i;
+      }
+    }
+
+    entry = &snmp_rate_limit_table[idx];
+    if (entry->in_use) {
+      snmp_rate_limit_unlink(idx);
+      evicted = 1;
+    }
+
+    ip_addr_copy(entry->source_ip, *source_ip);
+    entry->tokens = SNMP_RATE_LIMIT_TOKENS_MAX;
+    entry->last = now;
+    entry->in_use = 1;
+    entry->next = snmp_rate_limit_buckets[bucket];
+    snmp_rate_limit_buckets[bucket] = idx;
+  } else {
+    entry = &snmp_rate_limit_table[idx];
+
+    elapsed = now - entry->last;
+    if (elapsed >= (SNMP_RATE_LIMIT_TOKENS_MAX - entry->tokens + SNMP_RATE_LIMIT_RATE - 1) / SNMP_RATE_LIMIT_RATE) {
+      entry->tokens = SNMP_RATE_LIMIT_TOKENS_MAX;
+    } else {
+      entry->tokens += elapsed * SNMP_RATE_LIMIT_RATE;
+    }
+    entry->last = now;
+  }
+
+  if (entry->tokens >= SNMP_RATE_LIMIT_TOKENS_PER_REQUEST) {
+    entry->tokens -= SNMP_RATE_LIMIT_TOKENS_PER_REQUEST;
+    admit = 1;
+  } else {
+    admit = 0;
+  }
+
+  SYS_ARCH_UNPROTECT(old_level);
+
+  if (evicted) {
+    SNMP_STATS_INC(inratelimitevictions);
+  }
+  if (!admit) {
+    LWIP_DEBUGF(SNMP_DEBUG, ("snmp_rate_limit_admit(): drop request over rate limit\n"));
+    SNMP_STATS_INC(inratelimitdrops);
+  }
+
+  return admit;
+}
+#endif /* SNMP_RATE_LIMIT_SOURCES > 0 */
+
+#if SNMP_WALK_CACHE_SIZE > 0
+struct snmp_walk_cache_entry {
+  ip_addr_t source_ip;
+  u16_t source_port;
+  /* set while a GetNext of this manager is processed */
+  u8_t in_use;
+  /* sys_now() when last used */
+  u32_t used;
+  struct snmp_next_hint hint;
+#if SNMP_TABLE_NEXT_CELLS > 0
+  struct snmp_next_cells next_cells;
+#endif
+};
+
+static struct snmp_walk_cache_entry snmp_walk_cache[SNMP_WALK_CACHE_SIZE];
+
+/**
+ * Takes the walk position of the manager a GetNext request came from, or the least recently used one for a new manager.
+ * Returns NULL if another request of the same manager holds the position.
+ */
+static struct snmp_walk_cache_entry *
+snmp_walk_cache_claim(const struct snmp_request *request)
+{
+  struct snmp_walk_cache_entry *entry = NULL;
+  struct snmp_walk_cache_entry *lru = NULL;
+  u32_t now = sys_now();
+  u8_t i;
+  SYS_ARCH_DECL_PROTECT(old_level);
+
+  SYS_ARCH_PROTECT(old_level);
+  for (i = 0; i < SNMP_WALK_CACHE_SIZE; i++) {
+    if ((snmp_walk_cache[i].source_port == request->source_port) &&
+        ip_addr_cmp(&snmp_walk_cache[i].source_ip, request->source_ip)) {
+      entry = &snmp_walk_cache[i];
+      break;
+    }
+    if (!snmp_walk_cache[i].in_use &&
+        ((lru == NULL) || ((u32_t)(now - snmp_walk_cache[i].used) > (u32_t)(now - lru->used)))) {
+      lru = &snmp_walk_cache[i];
+    }
+  }
+
+  if (entry == NULL) {
+    entry = lru;
+    if (entry != NULL) {
+      ip_addr_copy(entry->source_ip, *request->source_ip);
+      entry->source_port     = request->source_port;
+      entry->hint.generation = 0;
+    }
+  } else if (entry->in_use) {
+    entry = NULL;
+  }
+
+  if (entry != NULL) {
+    if (((u32_t)(now - entry->used) > SNMP_WALK_CACHE_TIMEOUT) || (entry->hint.generation != request->next_hint_generation)) {
+      /* walk was abandoned or data changed meanwhile, start over */
+      entry->hint.generation = 0;
+#if SNMP_TABLE_NEXT_CELLS > 0
+      entry->next_cells.node = NULL;
+#endif
+    }
+#if SNMP_TABLE_NEXT_CELLS > 0
+    if ((u32_t)(now - entry->next_cells.fetched) > SNMP_WALK_CACHE_TIMEOUT) {
+      /* a walk going on keeps the position, but fetches the cells again */
+      entry->next_cells.node = NULL;
+    }
+#endif
+    entry->hint.request_generation = request->next_hint_generation;
+    entry->in_use = 1;
+    entry->used   = now;
+  }
+  SYS_ARCH_UNPROTECT(old_level);
+
+  return entry;
+}
+
+static void
+snmp_walk_cache_release(struct snmp_walk_cache_entry *entry)
+{
+  SYS_ARCH_DECL_PROTECT(old_level);
+
+  SYS_ARCH_PROTECT(old_level);
+  entry->in_use = 0;
+  SYS_ARCH_UNPROTECT(old_level);
+}
+#endif /* SNMP_WALK_CACHE_SIZE > 0 */
+
+#if SNMP_VALUE_CACHE_SIZE > 0
+#if SNMP_VALUE_CACHE_SIZE > 255
+#error SNMP_VALUE_CACHE_SIZE must fit into u8_t
+#endif
+
+struct snmp_value_cache_entry {
+  u32_t oid[SNMP_VALUE_CACHE_OID_LEN];
+  /* 0 if entry is unused */
+  u8_t oid_len;
+  u8_t asn1_type;
+  u16_t value_len;
+  /* sys_now() when the value gets stale */
+  u32_t expires;
+  /* snmp_value_cache_clock when last used */
+  u32_t used;
+  u8_t value[SNMP_VALUE_CACHE_VALUE_LEN];
+};
+
+static struct snmp_value_cache_entry snmp_value_cache[SNMP_VALUE_CACHE_SIZE];
+static u32_t snmp_value_cache_clock;
+
+/* must be called with SYS_ARCH_PROTECT held */
+static struct snmp_value_cache_entry *
+snmp_value_cache_find(const struct snmp_obj_id *oid)
+{
+  u8_t i;
+
+  for (i = 0; i < SNMP_VALUE_CACHE_SIZE; i++) {
+    struct snmp_value_cache_entry *entry = &snmp_value_cache[i];
+    /* compare last sub-identifier first, it differs most often */
+    if ((entry->oid_len == oid->len) && (entry->oid[oid->len - 1] == oid->id[oid->len - 1]) &&
+        (memcmp(entry->oid, oid->id, oid->len * sizeof(u32_t)) == 0)) {
+      return entry;
+    }
+  }
+
+  return NULL;
+}
+
+/**
+ * Fills in value and type of vb from the value cache.
+ * Returns 1 if vb->oid was cached, is not stale and may be returned to the request.
+ */
+static u8_t
+snmp_value_cache_get(struct snmp_request *request, struct snmp_varbind *vb)
+{
+  struct snmp_value_cache_entry *entry;
+  u8_t hit = 0;
+  SYS_ARCH_DECL_PROTECT(old_level);
+
+  if ((vb->oid.len == 0) || (vb->oid.len > SNMP_VALUE_CACHE_OID_LEN)) {
+    return 0;
+  }
+
+  SYS_ARCH_PROTECT(old_level);
+  entry = snmp_value_cache_find(&vb->oid);
+  if ((entry != NULL) && ((s32_t)(entry->expires - sys_now()) > 0)
+#if LWIP_HAVE_INT64
+      /* v1 requests must not see Counter64 objects (RFC 2089) */
+      && !((entry->asn1_type == SNMP_ASN1_TYPE_COUNTER64) && (request->version == SNMP_VERSION_1))
+#endif
+     ) {
+    vb->type      = entry->asn1_type;
+    vb->value_len = entry->value_len;
+    MEMCPY(vb->value, entry->value, entry->value_len & ~SNMP_GET_VALUE_RAW_DATA);
+    entry->used   = ++snmp_value_cache_clock;
+    hit = 1;
+  }
+  SYS_ARCH_UNPROTECT(old_level);
+
+  if (hit) {
+    SNMP_REQUEST_STATS_INC(request, valuecachehits);
+  }
+  return hit;
+}
+
+/** Stores the value read for vb for ttl milliseconds, replacing the least recently used value. */
+static void
+snmp_value_cache_put(struct snmp_request *request, const struct snmp_varbind *vb, u16_t ttl)
+{
+  struct snmp_value_cache_entry *entry;
+  SYS_ARCH_DECL_PROTECT(old_level);
+
+  SNMP_REQUEST_STATS_INC(request, valuecachemisses);
+
+  if ((vb->oid.len == 0) || (vb->oid.len > SNMP_VALUE_CACHE_OID_LEN) ||
+      ((vb->value_len & ~SNMP_GET_VALUE_RAW_DATA) > SNMP_VALUE_CACHE_VALUE_LEN)) {
+    return;
+  }
+
+  SYS_ARCH_PROTECT(old_level);
+  entry = snmp_value_cache_find(&vb->oid);
+  if (entry == NULL) {
+    u8_t i;
+
+    entry = &snmp_value_cache[0];
+    for (i = 1; (i < SNMP_VALUE_CACHE_SIZE) && (entry->oid_len != 0); i++) {
+      if ((snmp_value_cache[i].oid_len == 0) || (snmp_value_cache[i].used < entry->used)) {
+        entry = &snmp_value_cache[i];
+      }
+    }
+    MEMCPY(entry->oid, vb->oid.id, vb->oid.len * sizeof(u32_t));
+    entry->oid_len = vb->oid.len;
+  }
+  entry->asn1_type = vb->type;
+  entry->value_len = vb->value_len;
+  MEMCPY(entry->value, vb->value, vb->value_len & ~SNMP_GET_VALUE_RAW_DATA);
+  entry->expires   = sys_now() + ttl;
+  entry->used      = ++snmp_value_cache_clock;
+  SYS_ARCH_UNPROTECT(old_level);
+}
+
+/** Drops all cached values, because the MIB tree or the data behind it changed. */
+void
+snmp_value_cache_flush(void)
+{
+  u8_t i;
+  SYS_ARCH_DECL_PROTECT(old_level);
+
+  SYS_ARCH_PROTECT(old_level);
+  for (i = 0; i < SNMP_VALUE_CACHE_SIZE; i++) {
+    snmp_value_cache[i].oid_len = 0;
+  }
+  SYS_ARCH_UNPROTECT(old_level);
+}
+#endif /* SNMP_VALUE_CACHE_SIZE > 0 */
+
 /* ----------------------------------------------------------------------- */
 /* forward declarations */
 /* ----------------------------------------------------------------------- */
@@ -273,18 +1109,60 @@ snmp_receive(void *handle, struct pbuf *p, const ip_addr_t *source_ip, u16_t por
 {
   err_t err;
   struct snmp_request request;
+#if SNMP_RESPONSE_CACHE_SIZE > 0
+  struct pbuf *response;
+#endif
+#if SNMP_WORKER_THREADS > 1
+  u8_t set_locked = 0;
+#endif
+  SNMP_PROFILE_DECL(start)
 
   memset(&request, 0, sizeof(request));
   request.handle       = handle;
   request.source_ip    = source_ip;
   request.source_port  = port;
   request.inbound_pbuf = p;
+#if SNMP_WORKER_THREADS > 1
+  request.stats        = snmp_stats_shard_alloc();
+#endif
+#if SNMP_WALK_CACHE_SIZE > 0
+  request.next_hint_generation = snmp_next_hint_generation;
+#endif
+#if SNMP_MIB_REGISTRY_SIZE > 0
+  request.mib_registry = snmp_mib_registry_acquire(snmp_request_mib_registry_reader(&request));
+#endif
 
-  snmp_stats.inpkts++;
+  SNMP_REQUEST_STATS_INC(&request, inpkts);
 
+  SNMP_PROFILE_BEGIN(start);
   err = snmp_parse_inbound_frame(&request);
+  SNMP_PROFILE_END(&request, SNMP_PROFILE_PARSE, start);
   if (err == ERR_OK) {
+#if SNMP_WORKER_THREADS > 1
+    if (request.request_type == SNMP_ASN1_CONTEXT_PDU_SET_REQ) {
+      /* held from cache lookup until the response is cached, so a retransmission
+         processed by another worker replays it instead of applying the SET again */
+      sys_mutex_lock(&snmp_set_mutex);
+      set_locked = 1;
+    }
+#endif
+#if SNMP_RESPONSE_CACHE_SIZE > 0
+    response = snmp_response_cache_lookup(&request);
+    if (response != NULL) {
+      /* retransmission, already processed */
+#if SNMP_WORKER_THREADS > 1
+      if (set_locked) {
+        sys_mutex_unlock(&snmp_set_mutex);
+      }
+#endif
+      snmp_response_cache_replay(&request, response);
+      snmp_request_done(&request);
+      return;
+    }
+#endif
+    SNMP_PROFILE_BEGIN(start);
     err = snmp_prepare_outbound_frame(&request);
+    SNMP_PROFILE_END(&request, SNMP_PROFILE_ENCODE, start);
     if (err == ERR_OK) {
 
       if (request.error_status == SNMP_ERR_NOERROR) {
@@ -302,47 +1180,49 @@ snmp_receive(void *handle, struct pbuf *p, const ip_addr_t *source_ip, u16_t por
 #if LWIP_SNMP_V3
       else {
         struct snmp_varbind vb;
+        u32_t counter;
 
         vb.next = NULL;
         vb.prev = NULL;
         vb.type = SNMP_ASN1_TYPE_COUNTER32;
+        vb.value = &counter;
         vb.value_len = sizeof(u32_t);
 
         switch (request.error_status) {
           case SNMP_ERR_AUTHORIZATIONERROR: {
             static const u32_t oid[] = { 1, 3, 6, 1, 6, 3, 15, 1, 1, 5, 0 };
             snmp_oid_assign(&vb.oid, oid, LWIP_ARRAYSIZE(oid));
-            vb.value = &snmp_stats.wrongdigests;
+            counter = SNMP_STATS_GET(wrongdigests);
           }
           break;
           case SNMP_ERR_UNKNOWN_ENGINEID: {
             static const u32_t oid[] = { 1, 3, 6, 1, 6, 3, 15, 1, 1, 4, 0 };
             snmp_oid_assign(&vb.oid, oid, LWIP_ARRAYSIZE(oid));
-            vb.value = &snmp_stats.unknownengineids;
+            counter = SNMP_STATS_GET(unknownengineids);
           }
           break;
           case SNMP_ERR_UNKNOWN_SECURITYNAME: {
             static const u32_t oid[] = { 1, 3, 6, 1, 6, 3, 15, 1, 1, 3, 0 };
             snmp_oid_assign(&vb.oid, oid, LWIP_ARRAYSIZE(oid));
-            vb.value = &snmp_stats.unknownusernames;
+            counter = SNMP_STATS_GET(unknownusernames);
           }
           break;
           case SNMP_ERR_UNSUPPORTED_SECLEVEL: {
             static const u32_t oid[] = { 1, 3, 6, 1, 6, 3, 15, 1, 1, 1, 0 };
             snmp_oid_assign(&vb.oid, oid, LWIP_ARRAYSIZE(oid));
-            vb.value = &snmp_stats.unsupportedseclevels;
+            counter = SNMP_STATS_GET(unsupportedseclevels);
           }
           break;
           case SNMP_ERR_NOTINTIMEWINDOW: {
             static const u32_t oid[] = { 1, 3, 6, 1, 6, 3, 15, 1, 1, 2, 0 };
             snmp_oid_assign(&vb.oid, oid, LWIP_ARRAYSIZE(oid));
-            vb.value = &snmp_stats.notintimewindows;
+            counter = SNMP_STATS_GET(notintimewindows);
           }
           break;
           case SNMP_ERR_DECRYIPTION_ERROR: {
             static const u32_t oid[] = { 1, 3, 6, 1, 6, 3, 15, 1, 1, 6, 0 };
             snmp_oid_assign(&vb.oid, oid, LWIP_ARRAYSIZE(oid));
-            vb.value = &snmp_stats.decryptionerrors;
+            counter = SNMP_STATS_GET(decryptionerrors);
           }
           break;
           default:
@@ -351,7 +1231,7 @@ snmp_receive(void *handle, struct pbuf *p, const ip_addr_t *source_ip, u16_t por
         }
 
         if (err == ERR_OK) {
-          snmp_append_outbound_varbind(&(request.outbound_pbuf_stream), &vb);
+          snmp_msg_append_varbind(&request, &vb);
           request.error_status = SNMP_ERR_NOERROR;
         }
 
@@ -361,10 +1241,24 @@ snmp_receive(void *handle, struct pbuf *p, const ip_addr_t *source_ip, u16_t por
 #endif
 
       if (err == ERR_OK) {
+        SNMP_PROFILE_BEGIN(start);
         err = snmp_complete_outbound_frame(&request);
+        SNMP_PROFILE_END(&request, SNMP_PROFILE_ENCODE, start);
 
         if (err == ERR_OK) {
+#if SNMP_RESPONSE_CACHE_SIZE > 0
+          snmp_response_cache_insert(&request);
+#endif
+#if SNMP_WORKER_THREADS > 1
+          if (set_locked) {
+            sys_mutex_unlock(&snmp_set_mutex);
+            set_locked = 0;
+          }
+#endif
+
+          SNMP_PROFILE_BEGIN(start);
           err = snmp_sendto(request.handle, request.outbound_pbuf, request.source_ip, request.source_port);
+          SNMP_PROFILE_END(&request, SNMP_PROFILE_SENDTO, start);
 
           if ((request.request_type == SNMP_ASN1_CONTEXT_PDU_SET_REQ)
               && (request.error_status == SNMP_ERR_NOERROR)
@@ -379,7 +1273,15 @@ snmp_receive(void *handle, struct pbuf *p, const ip_addr_t *source_ip, u16_t por
     if (request.outbound_pbuf != NULL) {
       pbuf_free(request.outbound_pbuf);
     }
+#if SNMP_WORKER_THREADS > 1
+    if (set_locked) {
+      /* failed before the response was cached */
+      sys_mutex_unlock(&snmp_set_mutex);
+    }
+#endif
   }
+
+  snmp_request_done(&request);
 }
 
 static u8_t
@@ -404,17 +1306,50 @@ snmp_process_varbind(struct snmp_request *request, struct snmp_varbind *vb, u8_t
 {
   err_t err;
   struct snmp_node_instance node_instance;
+  SNMP_PROFILE_DECL(start)
+
+#if SNMP_VALUE_CACHE_SIZE > 0
+  if (!get_next && snmp_value_cache_get(request, vb)) {
+    /* cached values were readable when cached, no need to resolve the instance */
+    err = snmp_msg_append_varbind(request, vb);
+    if (err == ERR_BUF) {
+      request->error_status = SNMP_ERR_TOOBIG;
+    } else if (err != ERR_OK) {
+      request->error_status = SNMP_ERR_GENERROR;
+    }
+    return;
+  }
+#endif
+
   memset(&node_instance, 0, sizeof(node_instance));
+#if SNMP_TABLE_NEXT_CELLS > 0
+  node_instance.next_cells = request->next_cells;
+#endif
 
+  SNMP_PROFILE_BEGIN(start);
   if (get_next) {
     struct snmp_obj_id result_oid;
-    request->error_status = snmp_get_next_node_instance_from_oid(vb->oid.id, vb->oid.len, snmp_msg_getnext_validate_node_inst, request,  &result_oid, &node_instance);
+#if SNMP_WALK_CACHE_SIZE > 0
+    request->error_status = snmp_get_next_node_instance_from_oid(SNMP_REQUEST_MIB_REGISTRY(request), vb->oid.id, vb->oid.len, snmp_msg_getnext_validate_node_inst, request,  &result_oid, &node_instance, request->next_hint);
+    if (request->next_hint != NULL) {
+      if (request->next_hint->hit) {
+        SNMP_REQUEST_STATS_INC(request, walkcachehits);
+      } else {
+        SNMP_REQUEST_STATS_INC(request, walkcachemisses);
+      }
+    }
+#else
+    request->error_status = snmp_get_next_node_instance_from_oid(SNMP_REQUEST_MIB_REGISTRY(request), vb->oid.id, vb->oid.len, snmp_msg_getnext_validate_node_inst, request,  &result_oid, &node_instance, NULL);
+#endif
+
+    SNMP_PROFILE_END(request, SNMP_PROFILE_RESOLVE, start);
 
     if (request->error_status == SNMP_ERR_NOERROR) {
       snmp_oid_assign(&vb->oid, result_oid.id, result_oid.len);
     }
   } else {
-    request->error_status = snmp_get_node_instance_from_oid(vb->oid.id, vb->oid.len, &node_instance);
+    request->error_status = snmp_get_node_instance_from_oid(SNMP_REQUEST_MIB_REGISTRY(request), vb->oid.id, vb->oid.len, &node_instance);
+    SNMP_PROFILE_END(request, SNMP_PROFILE_RESOLVE, start);
 
     if (request->error_status == SNMP_ERR_NOERROR) {
       /* use 'getnext_validate' method for validation to avoid code duplication (some checks have to be executed here) */
@@ -429,13 +1364,14 @@ snmp_process_varbind(struct snmp_request *request, struct snmp_varbind *vb, u8_t
   }
 
   if (request->error_status != SNMP_ERR_NOERROR)  {
+    SNMP_PROFILE_SYNC(request, &node_instance);
     if (request->error_status >= SNMP_VARBIND_EXCEPTION_OFFSET) {
       if ((request->version == SNMP_VERSION_2c) || request->version == SNMP_VERSION_3) {
         /* in SNMP v2c a varbind related exception is stored in varbind and not in frame header */
         vb->type = (SNMP_ASN1_CONTENTTYPE_PRIMITIVE | SNMP_ASN1_CLASS_CONTEXT | (request->error_status & SNMP_VARBIND_EXCEPTION_MASK));
         vb->value_len = 0;
 
-        err = snmp_append_outbound_varbind(&(request->outbound_pbuf_stream), vb);
+        err = snmp_msg_append_varbind(request, vb);
         if (err == ERR_OK) {
           /* we stored the exception in varbind -> go on */
           request->error_status = SNMP_ERR_NOERROR;
@@ -450,14 +1386,46 @@ snmp_process_varbind(struct snmp_request *request, struct snmp_varbind *vb, u8_t
       request->error_status = SNMP_ERR_GENERROR;
     }
   } else {
-    s16_t len = node_instance.get_value(&node_instance, vb->value);
+    struct snmp_varbind_len vb_len;
+    s16_t len;
+
+    /* OID is known now, so the varbind without value gives a lower bound of its length:
+     * if that does not fit, reading the value is pointless (GetBulk stops here) */
+    vb->type = SNMP_ASN1_TYPE_NULL;
+    vb->value_len = 0;
+    if ((snmp_varbind_length(vb, &vb_len) == ERR_OK) &&
+        ((1 + vb_len.vb_len_len + vb_len.vb_value_len) > request->outbound_pbuf_stream.length)) {
+      request->error_status = SNMP_ERR_TOOBIG;
+      if (node_instance.release_instance != NULL) {
+        node_instance.release_instance(&node_instance);
+      }
+      SNMP_PROFILE_SYNC(request, &node_instance);
+      return;
+    }
+
+#if SNMP_VALUE_CACHE_SIZE > 0
+    if ((node_instance.cache_ttl > 0) && get_next && snmp_value_cache_get(request, vb)) {
+      len = (s16_t)vb->value_len;
+    } else
+#endif
+    {
+      SNMP_PROFILE_BEGIN(start);
+      len = node_instance.get_value(&node_instance, vb->value);
+      SNMP_PROFILE_END(request, SNMP_PROFILE_GET_VALUE, start);
+      vb->type = node_instance.asn1_type;
+#if SNMP_VALUE_CACHE_SIZE > 0
+      if ((len >= 0) && (node_instance.cache_ttl > 0)) {
+        vb->value_len = (u16_t)len;
+        snmp_value_cache_put(request, vb, node_instance.cache_ttl);
+      }
+#endif
+    }
 
     if (len >= 0) {
       vb->value_len = (u16_t)len; /* cast is OK because we checked >= 0 above */
-      vb->type = node_instance.asn1_type;
 
       LWIP_ASSERT("SNMP_MAX_VALUE_SIZE is configured too low", (vb->value_len & ~SNMP_GET_VALUE_RAW_DATA) <= SNMP_MAX_VALUE_SIZE);
-      err = snmp_append_outbound_varbind(&request->outbound_pbuf_stream, vb);
+      err = snmp_msg_append_varbind(request, vb);
 
       if (err == ERR_BUF) {
         request->error_status = SNMP_ERR_TOOBIG;
@@ -471,6 +1439,7 @@ snmp_process_varbind(struct snmp_request *request, struct snmp_varbind *vb, u8_t
     if (node_instance.release_instance != NULL) {
       node_instance.release_instance(&node_instance);
     }
+    SNMP_PROFILE_SYNC(request, &node_instance);
   }
 }
 
@@ -521,6 +1490,9 @@ snmp_process_getnext_request(struct snmp_request *request)
 {
   snmp_vb_enumerator_err_t err;
   struct snmp_varbind vb;
+#if SNMP_WALK_CACHE_SIZE > 0
+  struct snmp_walk_cache_entry *walk = snmp_walk_cache_claim(request);
+#endif
   vb.value = request->value_buffer;
 
   LWIP_DEBUGF(SNMP_DEBUG, ("SNMP get-next request\n"));
@@ -529,7 +1501,22 @@ snmp_process_getnext_request(struct snmp_request *request)
     err = snmp_vb_enumerator_get_next(&request->inbound_varbind_enumerator, &vb);
     if (err == SNMP_VB_ENUMERATOR_ERR_OK) {
       if ((vb.type == SNMP_ASN1_TYPE_NULL) && (vb.value_len == 0)) {
+#if SNMP_WALK_CACHE_SIZE > 0
+        if ((walk != NULL) && (request->inbound_varbind_enumerator.varbind_count == 1)) {
+          /* a walk follows the first varbind */
+          request->next_hint = &walk->hint;
+#if SNMP_TABLE_NEXT_CELLS > 0
+          request->next_cells = &walk->next_cells;
+#endif
+        }
+#endif
         snmp_process_varbind(request, &vb, 1);
+#if SNMP_WALK_CACHE_SIZE > 0
+        request->next_hint = NULL;
+#if SNMP_TABLE_NEXT_CELLS > 0
+        request->next_cells = NULL;
+#endif
+#endif
       } else {
         request->error_status = SNMP_ERR_GENERROR;
       }
@@ -538,15 +1525,144 @@ snmp_process_getnext_request(struct snmp_request *request)
       break;
     } else if (err == SNMP_VB_ENUMERATOR_ERR_ASN1ERROR) {
       /* malformed ASN.1, don't answer */
+#if SNMP_WALK_CACHE_SIZE > 0
+      if (walk != NULL) {
+        snmp_walk_cache_release(walk);
+      }
+#endif
       return ERR_ARG;
     } else {
       request->error_status = SNMP_ERR_GENERROR;
     }
   }
 
+#if SNMP_WALK_CACHE_SIZE > 0
+  if (walk != NULL) {
+    snmp_walk_cache_release(walk);
+  }
+#endif
+
   return ERR_OK;
 }
 
+#if SNMP_GETBULK_CURSORS > 0
+struct snmp_getbulk_cursor {
+  /* OID returned for this repeater in the previous repetition */
+  struct snmp_obj_id oid;
+  u8_t end_of_mib_view;
+#if SNMP_TABLE_NEXT_CELLS > 0
+  /* table cells following oid, fetched from one scan */
+  struct snmp_next_cells next_cells;
+#endif
+};
+
+struct snmp_getbulk_cursor_set {
+  struct snmp_getbulk_cursor cursors[SNMP_GETBULK_CURSORS];
+  u8_t in_use;
+};
+
+/* one set per worker, kept out of the (small) worker stacks */
+static struct snmp_getbulk_cursor_set snmp_getbulk_cursor_sets[SNMP_WORKER_THREADS];
+
+static struct snmp_getbulk_cursor_set *
+snmp_getbulk_cursor_set_alloc(void)
+{
+  struct snmp_getbulk_cursor_set *set = NULL;
+  u8_t i;
+  SYS_ARCH_DECL_PROTECT(old_level);
+
+  SYS_ARCH_PROTECT(old_level);
+  for (i = 0; i < LWIP_ARRAYSIZE(snmp_getbulk_cursor_sets); i++) {
+    if (!snmp_getbulk_cursor_sets[i].in_use) {
+      set = &snmp_getbulk_cursor_sets[i];
+      set->in_use = 1;
+      break;
+    }
+  }
+  SYS_ARCH_UNPROTECT(old_level);
+
+  return set;
+}
+
+static void
+snmp_getbulk_cursor_set_free(struct snmp_getbulk_cursor_set *set)
+{
+  SYS_ARCH_DECL_PROTECT(old_level);
+
+  SYS_ARCH_PROTECT(old_level);
+  set->in_use = 0;
+  SYS_ARCH_UNPROTECT(old_level);
+}
+
+/**
+ * Process repetitions > 1 of a GetBulk request from the repeater cursors filled in by the first repetition.
+ *
+ * @param request points to the associated message process state
+ * @param cursors cursor of each repeater
+ * @param num_cursors number of repeaters
+ * @param repetitions number of repetitions left
+ */
+static void
+snmp_process_getbulk_repetitions(struct snmp_request *request, struct snmp_getbulk_cursor *cursors, u16_t num_cursors, s32_t repetitions)
+{
+  struct snmp_varbind vb;
+  u16_t i;
+
+  while ((request->error_status == SNMP_ERR_NOERROR) && (repetitions > 0)) {
+    u8_t all_endofmibview = 1;
+
+    for (i = 0; (i < num_cursors) && (request->error_status == SNMP_ERR_NOERROR); i++) {
+      snmp_oid_assign(&vb.oid, cursors[i].oid.id, cursors[i].oid.len);
+
+      if (cursors[i].end_of_mib_view) {
+        /* nothing behind this OID last time, so don't walk the MIB tree again */
+        err_t err;
+
+        vb.type = (SNMP_ASN1_CONTENTTYPE_PRIMITIVE | SNMP_ASN1_CLASS_CONTEXT | SNMP_ASN1_CONTEXT_VARBIND_END_OF_MIB_VIEW);
+        vb.value_len = 0;
+
+        err = snmp_msg_append_varbind(request, &vb);
+        if (err == ERR_BUF) {
+          request->error_status = SNMP_ERR_TOOBIG;
+        } else if (err != ERR_OK) {
+          request->error_status = SNMP_ERR_GENERROR;
+        }
+      } else {
+        vb.value = request->value_buffer;
+#if SNMP_TABLE_NEXT_CELLS > 0
+        request->next_cells = &cursors[i].next_cells;
+#endif
+        snmp_process_varbind(request, &vb, 1);
+#if SNMP_TABLE_NEXT_CELLS > 0
+        request->next_cells = NULL;
+#endif
+
+        if (request->error_status == SNMP_ERR_NOERROR) {
+          snmp_oid_assign(&cursors[i].oid, vb.oid.id, vb.oid.len);
+          if (vb.type == (SNMP_ASN1_CONTENTTYPE_PRIMITIVE | SNMP_ASN1_CLASS_CONTEXT | SNMP_ASN1_CONTEXT_VARBIND_END_OF_MIB_VIEW)) {
+            cursors[i].end_of_mib_view = 1;
+          } else {
+            all_endofmibview = 0;
+          }
+        }
+      }
+
+      if (request->error_status != SNMP_ERR_NOERROR) {
+        /* already set correct error-index (here it cannot be taken from inbound varbind enumerator) */
+        request->error_index = request->non_repeaters + i + 1;
+      }
+    }
+
+    if ((request->error_status == SNMP_ERR_NOERROR) && all_endofmibview) {
+      /* stop when all varbinds in a loop return EndOfMibView */
+      break;
+    }
+
+    repetitions--;
+  }
+}
+#endif /* SNMP_GETBULK_CURSORS > 0 */
+
 /**
  * Service an internal or external event for SNMP GETBULKT.
  *
@@ -561,6 +1677,12 @@ snmp_process_getbulk_request(struct snmp_request *request)
   u16_t repetition_offset = 0;
   struct snmp_varbind_enumerator repetition_varbind_enumerator;
   struct snmp_varbind vb;
+#if SNMP_GETBULK_CURSORS > 0
+  struct snmp_getbulk_cursor_set *cursor_set = snmp_getbulk_cursor_set_alloc();
+  u16_t num_cursors = 0;
+  /* set when a repeater did not get a cursor, repetitions are then taken from outbound buffer */
+  u8_t cursor_overflow = (cursor_set == NULL);
+#endif
   vb.value = request->value_buffer;
 
   if (SNMP_LWIP_GETBULK_MAX_REPETITIONS > 0) {
@@ -593,11 +1715,45 @@ snmp_process_getbulk_request(struct snmp_request *request)
     } else if ((err != SNMP_VB_ENUMERATOR_ERR_OK) || (vb.type != SNMP_ASN1_TYPE_NULL) || (vb.value_len != 0)) {
       request->error_status = SNMP_ERR_GENERROR;
     } else {
+#if SNMP_TABLE_NEXT_CELLS > 0
+      if ((non_repeaters <= 0) && !cursor_overflow && (num_cursors < SNMP_GETBULK_CURSORS)) {
+        cursor_set->cursors[num_cursors].next_cells.node = NULL;
+        if (repetitions > 0) {
+          /* further repetitions follow, fetch cells ahead */
+          request->next_cells = &cursor_set->cursors[num_cursors].next_cells;
+        }
+      }
+#endif
       snmp_process_varbind(request, &vb, 1);
+#if SNMP_TABLE_NEXT_CELLS > 0
+      request->next_cells = NULL;
+#endif
+#if SNMP_GETBULK_CURSORS > 0
+      if ((non_repeaters <= 0) && !cursor_overflow && (request->error_status == SNMP_ERR_NOERROR)) {
+        if (num_cursors < SNMP_GETBULK_CURSORS) {
+          snmp_oid_assign(&cursor_set->cursors[num_cursors].oid, vb.oid.id, vb.oid.len);
+          cursor_set->cursors[num_cursors].end_of_mib_view =
+            (vb.type == (SNMP_ASN1_CONTENTTYPE_PRIMITIVE | SNMP_ASN1_CLASS_CONTEXT | SNMP_ASN1_CONTEXT_VARBIND_END_OF_MIB_VIEW));
+          num_cursors++;
+        } else {
+          cursor_overflow = 1;
+        }
+      }
+#endif
       non_repeaters--;
     }
   }
 
+#if SNMP_GETBULK_CURSORS > 0
+  if (!cursor_overflow) {
+    snmp_process_getbulk_repetitions(request, cursor_set->cursors, num_cursors, repetitions);
+    repetitions = 0;
+  }
+  if (cursor_set != NULL) {
+    snmp_getbulk_cursor_set_free(cursor_set);
+  }
+#endif
+
   /* process repetitions > 1 */
   while ((request->error_status == SNMP_ERR_NOERROR) && (repetitions > 0) && (request->outbound_pbuf_stream.offset != repetition_offset)) {
 
@@ -655,6 +1811,7 @@ snmp_process_set_request(struct snmp_request *request)
 {
   snmp_vb_enumerator_err_t err;
   struct snmp_varbind vb;
+  SNMP_PROFILE_DECL(start)
   vb.value = request->value_buffer;
 
   LWIP_DEBUGF(SNMP_DEBUG, ("SNMP set request\n"));
@@ -666,7 +1823,15 @@ snmp_process_set_request(struct snmp_request *request)
       struct snmp_node_instance node_instance;
       memset(&node_instance, 0, sizeof(node_instance));
 
-      request->error_status = snmp_get_node_instance_from_oid(vb.oid.id, vb.oid.len, &node_instance);
+#if SNMP_SET_VARBIND_INDEX_SIZE > 0
+      if (request->inbound_varbind_enumerator.varbind_count <= SNMP_SET_VARBIND_INDEX_SIZE) {
+        request->set_varbind_index[request->inbound_varbind_enumerator.varbind_count - 1] = request->inbound_varbind_enumerator.span;
+      }
+#endif
+
+      SNMP_PROFILE_BEGIN(start);
+      request->error_status = snmp_get_node_instance_from_oid(SNMP_REQUEST_MIB_REGISTRY(request), vb.oid.id, vb.oid.len, &node_instance);
+      SNMP_PROFILE_END(request, SNMP_PROFILE_RESOLVE, start);
       if (request->error_status == SNMP_ERR_NOERROR) {
         if (node_instance.asn1_type != vb.type) {
           request->error_status = SNMP_ERR_WRONGTYPE;
@@ -674,7 +1839,9 @@ snmp_process_set_request(struct snmp_request *request)
           request->error_status = SNMP_ERR_NOTWRITABLE;
         } else {
           if (node_instance.set_test != NULL) {
+            SNMP_PROFILE_BEGIN(start);
             request->error_status = node_instance.set_test(&node_instance, vb.value_len, vb.value);
+            SNMP_PROFILE_END(request, SNMP_PROFILE_SET_VALUE, start);
           }
         }
 
@@ -682,6 +1849,7 @@ snmp_process_set_request(struct snmp_request *request)
           node_instance.release_instance(&node_instance);
         }
       }
+      SNMP_PROFILE_SYNC(request, &node_instance);
     } else if (err == SNMP_VB_ENUMERATOR_ERR_EOVB) {
       /* no more varbinds in request */
       break;
@@ -697,16 +1865,43 @@ snmp_process_set_request(struct snmp_request *request)
 
   /* perform real set operation on all objects */
   if (request->error_status == SNMP_ERR_NOERROR) {
-    snmp_vb_enumerator_init(&request->inbound_varbind_enumerator, request->inbound_pbuf, request->inbound_varbind_offset, request->inbound_varbind_len);
-    while (request->error_status == SNMP_ERR_NOERROR) {
-      err = snmp_vb_enumerator_get_next(&request->inbound_varbind_enumerator, &vb);
+    u16_t varbind_count = request->inbound_varbind_enumerator.varbind_count;
+    u16_t i;
+
+#if SNMP_WALK_CACHE_SIZE > 0
+    /* values or rows may change, walks have to resolve their position again */
+    snmp_next_hint_invalidate();
+#endif
+#if SNMP_SET_VARBIND_INDEX_SIZE > 0
+    if (varbind_count > SNMP_SET_VARBIND_INDEX_SIZE)
+#endif
+    {
+      snmp_vb_enumerator_init(&request->inbound_varbind_enumerator, request->inbound_pbuf, request->inbound_varbind_offset, request->inbound_varbind_len);
+    }
+    for (i = 0; (i < varbind_count) && (request->error_status == SNMP_ERR_NOERROR); i++) {
+#if SNMP_SET_VARBIND_INDEX_SIZE > 0
+      if (varbind_count <= SNMP_SET_VARBIND_INDEX_SIZE) {
+        /* decode OID and value from the position recorded by the test phase */
+        err = snmp_vb_span_decode(request->inbound_pbuf, &request->set_varbind_index[i], &vb);
+      } else
+#endif
+      {
+        err = snmp_vb_enumerator_get_next(&request->inbound_varbind_enumerator, &vb);
+      }
       if (err == SNMP_VB_ENUMERATOR_ERR_OK) {
         struct snmp_node_instance node_instance;
         memset(&node_instance, 0, sizeof(node_instance));
-        request->error_status = snmp_get_node_instance_from_oid(vb.oid.id, vb.oid.len, &node_instance);
+        SNMP_PROFILE_BEGIN(start);
+        request->error_status = snmp_get_node_instance_from_oid(SNMP_REQUEST_MIB_REGISTRY(request), vb.oid.id, vb.oid.len, &node_instance);
+        SNMP_PROFILE_END(request, SNMP_PROFILE_RESOLVE, start);
         if (request->error_status == SNMP_ERR_NOERROR) {
-          if (node_instance.set_value(&node_instance, vb.value_len, vb.value) != SNMP_ERR_NOERROR) {
-            if (request->inbound_varbind_enumerator.varbind_count == 1) {
+          snmp_err_t set_err;
+
+          SNMP_PROFILE_BEGIN(start);
+          set_err = node_instance.set_value(&node_instance, vb.value_len, vb.value);
+          SNMP_PROFILE_END(request, SNMP_PROFILE_SET_VALUE, start);
+          if (set_err != SNMP_ERR_NOERROR) {
+            if (i == 0) {
               request->error_status = SNMP_ERR_COMMITFAILED;
             } else {
               /* we cannot undo the set operations done so far */
@@ -718,14 +1913,20 @@ snmp_process_set_request(struct snmp_request *request)
             node_instance.release_instance(&node_instance);
           }
         }
-      } else if (err == SNMP_VB_ENUMERATOR_ERR_EOVB) {
-        /* no more varbinds in request */
-        break;
+        SNMP_PROFILE_SYNC(request, &node_instance);
       } else {
         /* first time enumerating varbinds work but second time not, although nothing should have changed in between ??? */
         request->error_status = SNMP_ERR_GENERROR;
       }
+
+      if (request->error_status != SNMP_ERR_NOERROR) {
+        request->error_index = i + 1;
+      }
     }
+#if SNMP_VALUE_CACHE_SIZE > 0
+    /* drop values cached before or while setting */
+    snmp_value_cache_flush();
+#endif
   }
 
   return ERR_OK;
@@ -734,14 +1935,14 @@ snmp_process_set_request(struct snmp_request *request)
 #define PARSE_EXEC(code, retValue) \
   if ((code) != ERR_OK) { \
     LWIP_DEBUGF(SNMP_DEBUG, ("Malformed ASN.1 detected.\n")); \
-    snmp_stats.inasnparseerrs++; \
+    SNMP_STATS_INC(inasnparseerrs); \
     return retValue; \
   }
 
 #define PARSE_ASSERT(cond, retValue) \
   if (!(cond)) { \
     LWIP_DEBUGF(SNMP_DEBUG, ("SNMP parse assertion failed!: " # cond)); \
-    snmp_stats.inasnparseerrs++; \
+    SNMP_STATS_INC(inasnparseerrs); \
     return retValue; \
   }
 
@@ -774,6 +1975,9 @@ snmp_parse_inbound_frame(struct snmp_request *request)
   snmpv3_auth_algo_t auth;
   snmpv3_priv_algo_t priv;
 #endif
+#if LWIP_SNMP_V3_CRYPTO
+  SNMP_PROFILE_DECL(start)
+#endif
 
   IF_PARSE_EXEC(snmp_pbuf_stream_init(&pbuf_stream, request->inbound_pbuf, 0, request->inbound_pbuf->tot_len));
 
@@ -801,7 +2005,7 @@ snmp_parse_inbound_frame(struct snmp_request *request)
 #endif
      ) {
     /* unsupported SNMP version */
-    snmp_stats.inbadversions++;
+    SNMP_REQUEST_STATS_INC(request, inbadversions);
     return ERR_ARG;
   }
   request->version = (u8_t)s32_value;
@@ -952,7 +2156,7 @@ snmp_parse_inbound_frame(struct snmp_request *request)
       if ((request->msg_authoritative_engine_id_len == 0) ||
           (request->msg_authoritative_engine_id_len != eid_len) ||
           (memcmp(eid, request->msg_authoritative_engine_id, eid_len) != 0)) {
-        snmp_stats.unknownengineids++;
+        SNMP_REQUEST_STATS_INC(request, unknownengineids);
         request->msg_flags = 0; /* noauthnopriv */
         request->error_status = SNMP_ERR_UNKNOWN_ENGINEID;
         return ERR_OK;
@@ -961,7 +2165,7 @@ snmp_parse_inbound_frame(struct snmp_request *request)
 
     /* 4) verify username */
     if (snmpv3_get_user((char *)request->msg_user_name, &auth, NULL, &priv, NULL)) {
-      snmp_stats.unknownusernames++;
+      SNMP_REQUEST_STATS_INC(request, unknownusernames);
       request->msg_flags = 0; /* noauthnopriv */
       request->error_status = SNMP_ERR_UNKNOWN_SECURITYNAME;
       return ERR_OK;
@@ -972,7 +2176,7 @@ snmp_parse_inbound_frame(struct snmp_request *request)
       case SNMP_V3_NOAUTHNOPRIV:
         if ((auth != SNMP_V3_AUTH_ALGO_INVAL) || (priv != SNMP_V3_PRIV_ALGO_INVAL)) {
           /* Invalid security level for user */
-          snmp_stats.unsupportedseclevels++;
+          SNMP_REQUEST_STATS_INC(request, unsupportedseclevels);
           request->msg_flags = SNMP_V3_NOAUTHNOPRIV;
           request->error_status = SNMP_ERR_UNSUPPORTED_SECLEVEL;
           return ERR_OK;
@@ -982,7 +2186,7 @@ snmp_parse_inbound_frame(struct snmp_request *request)
       case SNMP_V3_AUTHNOPRIV:
         if ((auth == SNMP_V3_AUTH_ALGO_INVAL) || (priv != SNMP_V3_PRIV_ALGO_INVAL)) {
           /* Invalid security level for user */
-          snmp_stats.unsupportedseclevels++;
+          SNMP_REQUEST_STATS_INC(request, unsupportedseclevels);
           request->msg_flags = SNMP_V3_NOAUTHNOPRIV;
           request->error_status = SNMP_ERR_UNSUPPORTED_SECLEVEL;
           return ERR_OK;
@@ -991,7 +2195,7 @@ snmp_parse_inbound_frame(struct snmp_request *request)
       case SNMP_V3_AUTHPRIV:
         if ((auth == SNMP_V3_AUTH_ALGO_INVAL) || (priv == SNMP_V3_PRIV_ALGO_INVAL)) {
           /* Invalid security level for user */
-          snmp_stats.unsupportedseclevels++;
+          SNMP_REQUEST_STATS_INC(request, unsupportedseclevels);
           request->msg_flags = SNMP_V3_NOAUTHNOPRIV;
           request->error_status = SNMP_ERR_UNSUPPORTED_SECLEVEL;
           return ERR_OK;
@@ -999,7 +2203,7 @@ snmp_parse_inbound_frame(struct snmp_request *request)
         break;
 #endif
       default:
-        snmp_stats.unsupportedseclevels++;
+        SNMP_REQUEST_STATS_INC(request, unsupportedseclevels);
         request->msg_flags = SNMP_V3_NOAUTHNOPRIV;
         request->error_status = SNMP_ERR_UNSUPPORTED_SECLEVEL;
         return ERR_OK;
@@ -1014,7 +2218,7 @@ snmp_parse_inbound_frame(struct snmp_request *request)
       struct snmp_pbuf_stream auth_stream;
 
       if (request->msg_authentication_parameters_len > SNMP_V3_MAX_AUTH_PARAM_LENGTH) {
-        snmp_stats.wrongdigests++;
+        SNMP_REQUEST_STATS_INC(request, wrongdigests);
         request->msg_flags = SNMP_V3_NOAUTHNOPRIV;
         request->error_status = SNMP_ERR_AUTHORIZATIONERROR;
         return ERR_OK;
@@ -1030,10 +2234,13 @@ snmp_parse_inbound_frame(struct snmp_request *request)
       IF_PARSE_EXEC(snmp_pbuf_stream_init(&auth_stream, request->inbound_pbuf, 0, request->inbound_pbuf->tot_len));
 
       IF_PARSE_EXEC(snmpv3_get_user((char *)request->msg_user_name, &auth, key, NULL, NULL));
-      IF_PARSE_EXEC(snmpv3_auth(&auth_stream, request->inbound_pbuf->tot_len, key, auth, hmac));
+      SNMP_PROFILE_BEGIN(start);
+      err = snmpv3_auth(&auth_stream, request->inbound_pbuf->tot_len, key, auth, hmac);
+      SNMP_PROFILE_END(request, SNMP_PROFILE_V3_SECURITY, start);
+      IF_PARSE_EXEC(err);
 
       if (memcmp(request->msg_authentication_parameters, hmac, SNMP_V3_MAX_AUTH_PARAM_LENGTH)) {
-        snmp_stats.wrongdigests++;
+        SNMP_REQUEST_STATS_INC(request, wrongdigests);
         request->msg_flags = SNMP_V3_NOAUTHNOPRIV;
         request->error_status = SNMP_ERR_AUTHORIZATIONERROR;
         return ERR_OK;
@@ -1043,7 +2250,7 @@ snmp_parse_inbound_frame(struct snmp_request *request)
       {
         s32_t boots = snmpv3_get_engine_boots_internal();
         if ((request->msg_authoritative_engine_boots != boots) || (boots == 2147483647UL)) {
-          snmp_stats.notintimewindows++;
+          SNMP_REQUEST_STATS_INC(request, notintimewindows);
           request->msg_flags = SNMP_V3_AUTHNOPRIV;
           request->error_status = SNMP_ERR_NOTINTIMEWINDOW;
           return ERR_OK;
@@ -1052,13 +2259,13 @@ snmp_parse_inbound_frame(struct snmp_request *request)
       {
         s32_t time = snmpv3_get_engine_time_internal();
         if (request->msg_authoritative_engine_time > (time + 150)) {
-          snmp_stats.notintimewindows++;
+          SNMP_REQUEST_STATS_INC(request, notintimewindows);
           request->msg_flags = SNMP_V3_AUTHNOPRIV;
           request->error_status = SNMP_ERR_NOTINTIMEWINDOW;
           return ERR_OK;
         } else if (time > 150) {
           if (request->msg_authoritative_engine_time < (time - 150)) {
-            snmp_stats.notintimewindows++;
+            SNMP_REQUEST_STATS_INC(request, notintimewindows);
             request->msg_flags = SNMP_V3_AUTHNOPRIV;
             request->error_status = SNMP_ERR_NOTINTIMEWINDOW;
             return ERR_OK;
@@ -1081,10 +2288,13 @@ snmp_parse_inbound_frame(struct snmp_request *request)
       IF_PARSE_ASSERT(parent_tlv_value_len > 0);
 
       IF_PARSE_EXEC(snmpv3_get_user((char *)request->msg_user_name, NULL, NULL, &priv, key));
-      if (snmpv3_crypt(&pbuf_stream, tlv.value_len, key,
-                       request->msg_privacy_parameters, request->msg_authoritative_engine_boots,
-                       request->msg_authoritative_engine_time, priv, SNMP_V3_PRIV_MODE_DECRYPT) != ERR_OK) {
-        snmp_stats.decryptionerrors++;
+      SNMP_PROFILE_BEGIN(start);
+      err = snmpv3_crypt(&pbuf_stream, tlv.value_len, key,
+                         request->msg_privacy_parameters, request->msg_authoritative_engine_boots,
+                         request->msg_authoritative_engine_time, priv, SNMP_V3_PRIV_MODE_DECRYPT);
+      SNMP_PROFILE_END(request, SNMP_PROFILE_V3_SECURITY, start);
+      if (err != ERR_OK) {
+        SNMP_REQUEST_STATS_INC(request, decryptionerrors);
         request->msg_flags = SNMP_V3_AUTHNOPRIV;
         request->error_status = SNMP_ERR_DECRYIPTION_ERROR;
         return ERR_OK;
@@ -1157,11 +2367,11 @@ snmp_parse_inbound_frame(struct snmp_request *request)
   switch (tlv.type) {
     case (SNMP_ASN1_CLASS_CONTEXT | SNMP_ASN1_CONTENTTYPE_CONSTRUCTED | SNMP_ASN1_CONTEXT_PDU_GET_REQ):
       /* GetRequest PDU */
-      snmp_stats.ingetrequests++;
+      SNMP_REQUEST_STATS_INC(request, ingetrequests);
       break;
     case (SNMP_ASN1_CLASS_CONTEXT | SNMP_ASN1_CONTENTTYPE_CONSTRUCTED | SNMP_ASN1_CONTEXT_PDU_GET_NEXT_REQ):
       /* GetNextRequest PDU */
-      snmp_stats.ingetnexts++;
+      SNMP_REQUEST_STATS_INC(request, ingetnexts);
       break;
     case (SNMP_ASN1_CLASS_CONTEXT | SNMP_ASN1_CONTENTTYPE_CONSTRUCTED | SNMP_ASN1_CONTEXT_PDU_GET_BULK_REQ):
       /* GetBulkRequest PDU */
@@ -1172,7 +2382,7 @@ snmp_parse_inbound_frame(struct snmp_request *request)
       break;
     case (SNMP_ASN1_CLASS_CONTEXT | SNMP_ASN1_CONTENTTYPE_CONSTRUCTED | SNMP_ASN1_CONTEXT_PDU_SET_REQ):
       /* SetRequest PDU */
-      snmp_stats.insetrequests++;
+      SNMP_REQUEST_STATS_INC(request, insetrequests);
       break;
     default:
       /* unsupported input PDU for this agent (no parse error) */
@@ -1185,7 +2395,7 @@ snmp_parse_inbound_frame(struct snmp_request *request)
   /* validate community (do this after decoding PDU type because we don't want to increase 'inbadcommunitynames' for wrong frame types */
   if (request->community_strlen == 0) {
     /* community string was too long or really empty*/
-    snmp_stats.inbadcommunitynames++;
+    SNMP_REQUEST_STATS_INC(request, inbadcommunitynames);
     snmp_authfail_trap();
     return ERR_ARG;
   } else if (request->request_type == SNMP_ASN1_CONTEXT_PDU_SET_REQ) {
@@ -1195,14 +2405,14 @@ snmp_parse_inbound_frame(struct snmp_request *request)
       request->error_index  = 1;
     } else if (strncmp(snmp_community_write, (const char *)request->community, SNMP_MAX_COMMUNITY_STR_LEN) != 0) {
       /* community name does not match */
-      snmp_stats.inbadcommunitynames++;
+      SNMP_REQUEST_STATS_INC(request, inbadcommunitynames);
       snmp_authfail_trap();
       return ERR_ARG;
     }
   } else {
     if (strncmp(snmp_community, (const char *)request->community, SNMP_MAX_COMMUNITY_STR_LEN) != 0) {
       /* community name does not match */
-      snmp_stats.inbadcommunitynames++;
+      SNMP_REQUEST_STATS_INC(request, inbadcommunitynames);
       snmp_authfail_trap();
       return ERR_ARG;
     }
@@ -1264,20 +2474,108 @@ snmp_parse_inbound_frame(struct snmp_request *request)
 
 #define OF_BUILD_EXEC(code) BUILD_EXEC(code, ERR_ARG)
 
+/**
+ * Size of the response to a request: SNMP_MAX_MSG_SIZE, limited by the msgMaxSize of the manager (SNMPv3)
+ * and by the largest UDP payload the transport can deliver to the manager.
+ */
+static u16_t
+snmp_outbound_frame_size(struct snmp_request *request)
+{
+  u16_t size = SNMP_MAX_MSG_SIZE;
+  u16_t path_size;
+
+#if LWIP_SNMP_V3
+  if (request->version == SNMP_VERSION_3) {
+    /* a smaller msgMaxSize than allowed is taken as the minimum */
+    size = (u16_t)LWIP_MIN(size, LWIP_MAX(request->msg_max_size, SNMP_MIN_MSG_MAX_SIZE));
+  }
+#endif
+
+  path_size = snmp_get_max_payload_for_dst(request->handle, request->source_ip);
+  if ((path_size != 0) && (path_size < size)) {
+    size = path_size;
+  }
+
+  return size;
+}
+
+#if SNMP_RESPONSE_HEADER_TEMPLATES
+/* same frame as below, from the template and one buffer for the fields following it */
+static err_t
+snmp_prepare_outbound_frame_from_template(struct snmp_request *request, const struct snmp_response_header *header)
+{
+  struct snmp_pbuf_stream *pbuf_stream = &(request->outbound_pbuf_stream);
+  /* request ID (up to 4 value bytes), error status, error index, 'VarBindList' sequence */
+  u8_t fields[(2 + 4) + 3 + 3 + 4];
+  u16_t id_len;
+  u16_t len = 0;
+
+  OF_BUILD_EXEC( snmp_asn1_enc_raw(pbuf_stream, header->data, header->len) );
+  request->outbound_pdu_offset = pbuf_stream->offset - 4;
+
+  /* request ID */
+  snmp_asn1_enc_s32t_cnt(request->request_id, &id_len);
+  fields[len++] = SNMP_ASN1_TYPE_INTEGER;
+  fields[len++] = (u8_t)id_len;
+  while (id_len > 0) {
+    id_len--;
+    fields[len++] = (u8_t)((u32_t)request->request_id >> (id_len * 8));
+  }
+
+  /* error status */
+  fields[len++] = SNMP_ASN1_TYPE_INTEGER;
+  fields[len++] = 1;
+  request->outbound_error_status_offset = pbuf_stream->offset + len;
+  fields[len++] = 0;
+
+  /* error index */
+  fields[len++] = SNMP_ASN1_TYPE_INTEGER;
+  fields[len++] = 1;
+  request->outbound_error_index_offset = pbuf_stream->offset + len;
+  fields[len++] = 0;
+
+  /* 'VarBindList' sequence */
+  fields[len++] = SNMP_ASN1_TYPE_SEQUENCE;
+  fields[len++] = 0x82;
+  fields[len++] = 0;
+  fields[len++] = 0;
+
+  OF_BUILD_EXEC( snmp_asn1_enc_raw(pbuf_stream, fields, len) );
+
+  request->outbound_varbind_offset = pbuf_stream->offset;
+
+  return ERR_OK;
+}
+#endif
+
 static err_t
 snmp_prepare_outbound_frame(struct snmp_request *request)
 {
   struct snmp_asn1_tlv tlv;
   struct snmp_pbuf_stream *pbuf_stream = &(request->outbound_pbuf_stream);
+  u16_t frame_size = snmp_outbound_frame_size(request);
 
-  /* try allocating pbuf(s) for maximum response size */
-  request->outbound_pbuf = pbuf_alloc(PBUF_TRANSPORT, 1472, PBUF_RAM);
+  /* try allocating pbuf(s) for response size */
+#if SNMP_OUTBOUND_PBUF_POOL_SIZE > 0
+  request->outbound_pbuf = snmp_outbound_pbuf_alloc(request, frame_size);
+#else
+  request->outbound_pbuf = pbuf_alloc(PBUF_TRANSPORT, frame_size, PBUF_RAM);
+#endif
   if (request->outbound_pbuf == NULL) {
     return ERR_MEM;
   }
 
   snmp_pbuf_stream_init(pbuf_stream, request->outbound_pbuf, 0, request->outbound_pbuf->tot_len);
 
+#if SNMP_RESPONSE_HEADER_TEMPLATES
+  {
+    const struct snmp_response_header *header = snmp_response_header_get(request);
+    if (header != NULL) {
+      return snmp_prepare_outbound_frame_from_template(request, header);
+    }
+  }
+#endif
+
   /* 'Message' sequence */
   SNMP_ASN1_SET_TLV_PARAMS(tlv, SNMP_ASN1_TYPE_SEQUENCE, 3, 0);
   OF_BUILD_EXEC( snmp_ans1_enc_tlv(pbuf_stream, &tlv) );
@@ -1310,11 +2608,11 @@ snmp_prepare_outbound_frame(struct snmp_request *request)
     OF_BUILD_EXEC(snmp_ans1_enc_tlv(pbuf_stream, &tlv));
     OF_BUILD_EXEC(snmp_asn1_enc_s32t(pbuf_stream, tlv.value_len, request->msg_id));
 
-    /* msgMaxSize */
+    /* msgMaxSize (of this agent, RFC 3412) */
     SNMP_ASN1_SET_TLV_PARAMS(tlv, SNMP_ASN1_TYPE_INTEGER, 0, 1);
-    snmp_asn1_enc_s32t_cnt(request->msg_max_size, &tlv.value_len);
+    snmp_asn1_enc_s32t_cnt(SNMP_MAX_MSG_SIZE, &tlv.value_len);
     OF_BUILD_EXEC(snmp_ans1_enc_tlv(pbuf_stream, &tlv));
-    OF_BUILD_EXEC(snmp_asn1_enc_s32t(pbuf_stream, tlv.value_len, request->msg_max_size));
+    OF_BUILD_EXEC(snmp_asn1_enc_s32t(pbuf_stream, tlv.value_len, SNMP_MAX_MSG_SIZE));
 
     /* msgFlags */
     SNMP_ASN1_SET_TLV_PARAMS(tlv, SNMP_ASN1_TYPE_OCTET_STRING, 0, 1);
@@ -1604,6 +2902,10 @@ snmp_complete_outbound_frame(struct snmp_request *request)
   struct snmp_asn1_tlv tlv;
   u16_t frame_size;
   u8_t outbound_padding = 0;
+#if LWIP_SNMP_V3 && LWIP_SNMP_V3_CRYPTO
+  err_t err;
+  SNMP_PROFILE_DECL(start)
+#endif
 
   if (request->version == SNMP_VERSION_1) {
     if (request->error_status != SNMP_ERR_NOERROR) {
@@ -1666,7 +2968,13 @@ snmp_complete_outbound_frame(struct snmp_request *request)
     struct snmp_pbuf_stream inbound_stream;
     OF_BUILD_EXEC( snmp_pbuf_stream_init(&inbound_stream, request->inbound_pbuf, request->inbound_varbind_offset, request->inbound_varbind_len) );
     OF_BUILD_EXEC( snmp_pbuf_stream_init(&(request->outbound_pbuf_stream), request->outbound_pbuf, request->outbound_varbind_offset, request->outbound_pbuf->tot_len - request->outbound_varbind_offset) );
-    OF_BUILD_EXEC( snmp_pbuf_stream_writeto(&inbound_stream, &(request->outbound_pbuf_stream), 0) );
+    if (request->inbound_varbind_len > request->outbound_pbuf_stream.length) {
+      /* inbound vars do not fit into response size -> tooBig with empty varbind list (RFC 3416) */
+      request->error_status = SNMP_ERR_TOOBIG;
+      request->error_index  = 0;
+    } else {
+      OF_BUILD_EXEC( snmp_pbuf_stream_writeto(&inbound_stream, &(request->outbound_pbuf_stream), 0) );
+    }
   }
 
   frame_size = request->outbound_pbuf_stream.offset;
@@ -1734,17 +3042,17 @@ snmp_complete_outbound_frame(struct snmp_request *request)
     /* for compatibility to v1, log statistics; in v2 (RFC 1907) these statistics are obsoleted */
     switch (request->error_status) {
       case SNMP_ERR_TOOBIG:
-        snmp_stats.outtoobigs++;
+        SNMP_REQUEST_STATS_INC(request, outtoobigs);
         break;
       case SNMP_ERR_NOSUCHNAME:
-        snmp_stats.outnosuchnames++;
+        SNMP_REQUEST_STATS_INC(request, outnosuchnames);
         break;
       case SNMP_ERR_BADVALUE:
-        snmp_stats.outbadvalues++;
+        SNMP_REQUEST_STATS_INC(request, outbadvalues);
         break;
       case SNMP_ERR_GENERROR:
       default:
-        snmp_stats.outgenerrs++;
+        SNMP_REQUEST_STATS_INC(request, outgenerrs);
         break;
     }
 
@@ -1756,9 +3064,9 @@ snmp_complete_outbound_frame(struct snmp_request *request)
     }
   } else {
     if (request->request_type == SNMP_ASN1_CONTEXT_PDU_SET_REQ) {
-      snmp_stats.intotalsetvars += request->inbound_varbind_enumerator.varbind_count;
+      SNMP_REQUEST_STATS_ADD(request, intotalsetvars, request->inbound_varbind_enumerator.varbind_count);
     } else {
-      snmp_stats.intotalreqvars += request->inbound_varbind_enumerator.varbind_count;
+      SNMP_REQUEST_STATS_ADD(request, intotalreqvars, request->inbound_varbind_enumerator.varbind_count);
     }
   }
 
@@ -1795,9 +3103,12 @@ snmp_complete_outbound_frame(struct snmp_request *request)
 
     OF_BUILD_EXEC(snmpv3_get_user((char *)request->msg_user_name, NULL, NULL, &algo, key));
 
-    OF_BUILD_EXEC(snmpv3_crypt(&request->outbound_pbuf_stream, tlv.value_len, key,
-                               request->msg_privacy_parameters, request->msg_authoritative_engine_boots,
-                               request->msg_authoritative_engine_time, algo, SNMP_V3_PRIV_MODE_ENCRYPT));
+    SNMP_PROFILE_BEGIN(start);
+    err = snmpv3_crypt(&request->outbound_pbuf_stream, tlv.value_len, key,
+                       request->msg_privacy_parameters, request->msg_authoritative_engine_boots,
+                       request->msg_authoritative_engine_time, algo, SNMP_V3_PRIV_MODE_ENCRYPT);
+    SNMP_PROFILE_END(request, SNMP_PROFILE_V3_SECURITY, start);
+    OF_BUILD_EXEC(err);
   }
 
   if (request->version == SNMP_VERSION_3 && (request->msg_flags & SNMP_V3_AUTH_FLAG)) {
@@ -1808,7 +3119,10 @@ snmp_complete_outbound_frame(struct snmp_request *request)
     OF_BUILD_EXEC(snmpv3_get_user((char *)request->msg_user_name, &algo, key, NULL, NULL));
     OF_BUILD_EXEC(snmp_pbuf_stream_init(&(request->outbound_pbuf_stream),
                                         request->outbound_pbuf, 0, request->outbound_pbuf->tot_len));
-    OF_BUILD_EXEC(snmpv3_auth(&request->outbound_pbuf_stream, frame_size + outbound_padding, key, algo, hmac));
+    SNMP_PROFILE_BEGIN(start);
+    err = snmpv3_auth(&request->outbound_pbuf_stream, frame_size + outbound_padding, key, algo, hmac);
+    SNMP_PROFILE_END(request, SNMP_PROFILE_V3_SECURITY, start);
+    OF_BUILD_EXEC(err);
 
     MEMCPY(request->msg_authentication_parameters, hmac, SNMP_V3_MAX_AUTH_PARAM_LENGTH);
     OF_BUILD_EXEC(snmp_pbuf_stream_init(&request->outbound_pbuf_stream,
@@ -1825,8 +3139,8 @@ snmp_complete_outbound_frame(struct snmp_request *request)
 
   pbuf_realloc(request->outbound_pbuf, frame_size + outbound_padding);
 
-  snmp_stats.outgetresponses++;
-  snmp_stats.outpkts++;
+  SNMP_REQUEST_STATS_INC(request, outgetresponses);
+  SNMP_REQUEST_STATS_INC(request, outpkts);
 
   return ERR_OK;
 }
@@ -1860,51 +3174,31 @@ snmp_vb_enumerator_init(struct snmp_varbind_enumerator *enumerator, struct pbuf
 #define VB_PARSE_EXEC(code)   PARSE_EXEC(code, SNMP_VB_ENUMERATOR_ERR_ASN1ERROR)
 #define VB_PARSE_ASSERT(code) PARSE_ASSERT(code, SNMP_VB_ENUMERATOR_ERR_ASN1ERROR)
 
-snmp_vb_enumerator_err_t
-snmp_vb_enumerator_get_next(struct snmp_varbind_enumerator *enumerator, struct snmp_varbind *varbind)
+/* decodes a varbind value of type and value_len bytes into varbind (or just skips it if varbind->value is NULL) */
+static snmp_vb_enumerator_err_t
+snmp_vb_decode_value(struct snmp_pbuf_stream *pbuf_stream, u8_t type, u16_t value_len, struct snmp_varbind *varbind)
 {
-  struct snmp_asn1_tlv tlv;
-  u16_t  varbind_len;
-  err_t  err;
-
-  if (enumerator->pbuf_stream.length == 0) {
-    return SNMP_VB_ENUMERATOR_ERR_EOVB;
-  }
-  enumerator->varbind_count++;
-
-  /* decode varbind itself (parent container of a varbind) */
-  VB_PARSE_EXEC(snmp_asn1_dec_tlv(&(enumerator->pbuf_stream), &tlv));
-  VB_PARSE_ASSERT((tlv.type == SNMP_ASN1_TYPE_SEQUENCE) && (tlv.value_len <= enumerator->pbuf_stream.length));
-  varbind_len = tlv.value_len;
-
-  /* decode varbind name (object id) */
-  VB_PARSE_EXEC(snmp_asn1_dec_tlv(&(enumerator->pbuf_stream), &tlv));
-  VB_PARSE_ASSERT((tlv.type == SNMP_ASN1_TYPE_OBJECT_ID) && (SNMP_ASN1_TLV_LENGTH(tlv) < varbind_len) && (tlv.value_len < enumerator->pbuf_stream.length));
-
-  VB_PARSE_EXEC(snmp_asn1_dec_oid(&(enumerator->pbuf_stream), tlv.value_len, varbind->oid.id, &(varbind->oid.len), SNMP_MAX_OBJ_ID_LEN));
-  varbind_len -= SNMP_ASN1_TLV_LENGTH(tlv);
+  u8_t  oid_len;
+  err_t err;
 
-  /* decode varbind value (object id) */
-  VB_PARSE_EXEC(snmp_asn1_dec_tlv(&(enumerator->pbuf_stream), &tlv));
-  VB_PARSE_ASSERT((SNMP_ASN1_TLV_LENGTH(tlv) == varbind_len) && (tlv.value_len <= enumerator->pbuf_stream.length));
-  varbind->type = tlv.type;
+  varbind->type = type;
 
   /* shall the value be decoded ? */
   if (varbind->value != NULL) {
-    switch (varbind->type) {
+    switch (type) {
       case SNMP_ASN1_TYPE_INTEGER:
-        VB_PARSE_EXEC(snmp_asn1_dec_s32t(&(enumerator->pbuf_stream), tlv.value_len, (s32_t *)varbind->value));
+        VB_PARSE_EXEC(snmp_asn1_dec_s32t(pbuf_stream, value_len, (s32_t *)varbind->value));
         varbind->value_len = sizeof(s32_t);
         break;
       case SNMP_ASN1_TYPE_COUNTER:
       case SNMP_ASN1_TYPE_GAUGE:
       case SNMP_ASN1_TYPE_TIMETICKS:
-        VB_PARSE_EXEC(snmp_asn1_dec_u32t(&(enumerator->pbuf_stream), tlv.value_len, (u32_t *)varbind->value));
+        VB_PARSE_EXEC(snmp_asn1_dec_u32t(pbuf_stream, value_len, (u32_t *)varbind->value));
         varbind->value_len = sizeof(u32_t);
         break;
       case SNMP_ASN1_TYPE_OCTET_STRING:
       case SNMP_ASN1_TYPE_OPAQUE:
-        err = snmp_asn1_dec_raw(&(enumerator->pbuf_stream), tlv.value_len, (u8_t *)varbind->value, &varbind->value_len, SNMP_MAX_VALUE_SIZE);
+        err = snmp_asn1_dec_raw(pbuf_stream, value_len, (u8_t *)varbind->value, &varbind->value_len, SNMP_MAX_VALUE_SIZE);
         if (err == ERR_MEM) {
           return SNMP_VB_ENUMERATOR_ERR_INVALIDLENGTH;
         }
@@ -1914,25 +3208,24 @@ snmp_vb_enumerator_get_next(struct snmp_varbind_enumerator *enumerator, struct s
         varbind->value_len = 0;
         break;
       case SNMP_ASN1_TYPE_OBJECT_ID:
-        /* misuse tlv.length_len as OID_length transporter */
-        err = snmp_asn1_dec_oid(&(enumerator->pbuf_stream), tlv.value_len, (u32_t *)varbind->value, &tlv.length_len, SNMP_MAX_OBJ_ID_LEN);
+        err = snmp_asn1_dec_oid(pbuf_stream, value_len, (u32_t *)varbind->value, &oid_len, SNMP_MAX_OBJ_ID_LEN);
         if (err == ERR_MEM) {
           return SNMP_VB_ENUMERATOR_ERR_INVALIDLENGTH;
         }
         VB_PARSE_ASSERT(err == ERR_OK);
-        varbind->value_len = tlv.length_len * sizeof(u32_t);
+        varbind->value_len = oid_len * sizeof(u32_t);
         break;
       case SNMP_ASN1_TYPE_IPADDR:
-        if (tlv.value_len == 4) {
+        if (value_len == 4) {
           /* must be exactly 4 octets! */
-          VB_PARSE_EXEC(snmp_asn1_dec_raw(&(enumerator->pbuf_stream), tlv.value_len, (u8_t *)varbind->value, &varbind->value_len, SNMP_MAX_VALUE_SIZE));
+          VB_PARSE_EXEC(snmp_asn1_dec_raw(pbuf_stream, value_len, (u8_t *)varbind->value, &varbind->value_len, SNMP_MAX_VALUE_SIZE));
         } else {
           VB_PARSE_ASSERT(0);
         }
         break;
 #if LWIP_HAVE_INT64
       case SNMP_ASN1_TYPE_COUNTER64:
-        VB_PARSE_EXEC(snmp_asn1_dec_u64t(&(enumerator->pbuf_stream), tlv.value_len, (u64_t *)varbind->value));
+        VB_PARSE_EXEC(snmp_asn1_dec_u64t(pbuf_stream, value_len, (u64_t *)varbind->value));
         varbind->value_len = sizeof(u64_t);
         break;
 #endif
@@ -1941,11 +3234,62 @@ snmp_vb_enumerator_get_next(struct snmp_varbind_enumerator *enumerator, struct s
         break;
     }
   } else {
-    snmp_pbuf_stream_seek(&(enumerator->pbuf_stream), tlv.value_len);
-    varbind->value_len = tlv.value_len;
+    snmp_pbuf_stream_seek(pbuf_stream, value_len);
+    varbind->value_len = value_len;
   }
 
   return SNMP_VB_ENUMERATOR_ERR_OK;
 }
 
+snmp_vb_enumerator_err_t
+snmp_vb_enumerator_get_next(struct snmp_varbind_enumerator *enumerator, struct snmp_varbind *varbind)
+{
+  struct snmp_asn1_tlv tlv;
+  u16_t  varbind_len;
+
+  if (enumerator->pbuf_stream.length == 0) {
+    return SNMP_VB_ENUMERATOR_ERR_EOVB;
+  }
+  enumerator->varbind_count++;
+
+  /* decode varbind itself (parent container of a varbind) */
+  VB_PARSE_EXEC(snmp_asn1_dec_tlv(&(enumerator->pbuf_stream), &tlv));
+  VB_PARSE_ASSERT((tlv.type == SNMP_ASN1_TYPE_SEQUENCE) && (tlv.value_len <= enumerator->pbuf_stream.length));
+  varbind_len = tlv.value_len;
+
+  /* decode varbind name (object id) */
+  VB_PARSE_EXEC(snmp_asn1_dec_tlv(&(enumerator->pbuf_stream), &tlv));
+  VB_PARSE_ASSERT((tlv.type == SNMP_ASN1_TYPE_OBJECT_ID) && (SNMP_ASN1_TLV_LENGTH(tlv) < varbind_len) && (tlv.value_len < enumerator->pbuf_stream.length));
+
+  enumerator->span.oid_offset = enumerator->pbuf_stream.offset;
+  enumerator->span.oid_len    = tlv.value_len;
+  VB_PARSE_EXEC(snmp_asn1_dec_oid(&(enumerator->pbuf_stream), tlv.value_len, varbind->oid.id, &(varbind->oid.len), SNMP_MAX_OBJ_ID_LEN));
+  varbind_len -= SNMP_ASN1_TLV_LENGTH(tlv);
+
+  /* decode varbind value (object id) */
+  VB_PARSE_EXEC(snmp_asn1_dec_tlv(&(enumerator->pbuf_stream), &tlv));
+  VB_PARSE_ASSERT((SNMP_ASN1_TLV_LENGTH(tlv) == varbind_len) && (tlv.value_len <= enumerator->pbuf_stream.length));
+
+  enumerator->span.value_offset = enumerator->pbuf_stream.offset;
+  enumerator->span.value_len    = tlv.value_len;
+  enumerator->span.type         = tlv.type;
+  return snmp_vb_decode_value(&(enumerator->pbuf_stream), tlv.type, tlv.value_len, varbind);
+}
+
+/**
+ * Decodes the varbind at span again, span was filled by snmp_vb_enumerator_get_next()
+ * for the same pbuf, so the varbind framing is known to be valid.
+ */
+snmp_vb_enumerator_err_t
+snmp_vb_span_decode(struct pbuf *p, const struct snmp_varbind_span *span, struct snmp_varbind *varbind)
+{
+  struct snmp_pbuf_stream pbuf_stream;
+
+  VB_PARSE_EXEC(snmp_pbuf_stream_init(&pbuf_stream, p, span->oid_offset, span->oid_len));
+  VB_PARSE_EXEC(snmp_asn1_dec_oid(&pbuf_stream, span->oid_len, varbind->oid.id, &(varbind->oid.len), SNMP_MAX_OBJ_ID_LEN));
+
+  VB_PARSE_EXEC(snmp_pbuf_stream_init(&pbuf_stream, p, span->value_offset, span->value_len));
+  return snmp_vb_decode_value(&pbuf_stream, span->type, span->value_len, varbind);
+}
+
 #endif /* LWIP_SNMP */
@@ -62,9 +62,20 @@ extern "C" {
 #define SNMP_VERSION_2c 1
 #define SNMP_VERSION_3  3
 
+/** Position of the encoded OID and value of one inbound varbind */
+struct snmp_varbind_span {
+  u16_t oid_offset;
+  u16_t oid_len;
+  u16_t value_offset;
+  u16_t value_len;
+  u8_t  type;
+};
+
 struct snmp_varbind_enumerator {
   struct snmp_pbuf_stream pbuf_stream;
   u16_t varbind_count;
+  /* position of the varbind returned last */
+  struct snmp_varbind_span span;
 };
 
 typedef enum {
@@ -76,6 +87,7 @@ typedef enum {
 
 void snmp_vb_enumerator_init(struct snmp_varbind_enumerator *enumerator, struct pbuf *p, u16_t offset, u16_t length);
 snmp_vb_enumerator_err_t snmp_vb_enumerator_get_next(struct snmp_varbind_enumerator *enumerator, struct snmp_varbind *varbind);
+snmp_vb_enumerator_err_t snmp_vb_span_decode(struct pbuf *p, const struct snmp_varbind_span *span, struct snmp_varbind *varbind);
 
 struct snmp_request {
   /* Communication handle */
@@ -84,6 +96,10 @@ struct snmp_request {
   const ip_addr_t *source_ip;
   /* source UDP port */
   u16_t source_port;
+#if SNMP_WORKER_THREADS > 1
+  /* statistics shard of the worker processing the request, NULL to update the shared shard */
+  struct snmp_statistics *stats;
+#endif
   /* incoming snmp version */
   u8_t version;
   /* community name (zero terminated) */
@@ -132,6 +148,10 @@ struct snmp_request {
   u16_t inbound_varbind_offset;
   u16_t inbound_varbind_len;
   u16_t inbound_padding_len;
+#if SNMP_SET_VARBIND_INDEX_SIZE > 0
+  /* varbinds of a SET request recorded by the test phase for the commit phase */
+  struct snmp_varbind_span set_varbind_index[SNMP_SET_VARBIND_INDEX_SIZE];
+#endif
 
   struct pbuf *outbound_pbuf;
   struct snmp_pbuf_stream outbound_pbuf_stream;
@@ -150,6 +170,27 @@ struct snmp_request {
   u16_t outbound_scoped_pdu_string_offset;
 #endif
 
+#if SNMP_TABLE_NEXT_CELLS > 0
+  /* cells fetched ahead for the GetBulk repeater or walk being processed, NULL otherwise */
+  struct snmp_next_cells *next_cells;
+#endif
+#if SNMP_WALK_CACHE_SIZE > 0
+  /* walk position of the manager for the GetNext varbind being processed, NULL otherwise */
+  struct snmp_next_hint *next_hint;
+  /* snmp_next_hint_generation when the request started, read before pinning the MIBs */
+  u32_t next_hint_generation;
+#endif
+#if SNMP_MIB_REGISTRY_SIZE > 0
+  /* MIBs pinned for the whole request, changes apply to the requests after */
+  const struct snmp_mib_registry *mib_registry;
+#endif
+#if SNMP_PROFILE
+  /* ticks spent in each phase so far, see SNMP_PROFILE */
+  u32_t profile_ticks[SNMP_PROFILE_PHASES];
+  /* bit n is set if phase n was entered */
+  u16_t profile_phases;
+#endif
+
   u8_t value_buffer[SNMP_MAX_VALUE_SIZE];
 };
 
@@ -170,9 +211,22 @@ extern const char *snmp_community_write;
 /** handle for sending traps */
 extern void *snmp_traps_handle;
 
+#if SNMP_WORKER_THREADS > 1
+void snmp_msg_init(void);
+#endif
+#if SNMP_TRAP_QUEUE_SIZE > 0
+void snmp_trap_queue_init(void);
+#endif
+#if SNMP_RATE_LIMIT_SOURCES > 0
+u8_t snmp_rate_limit_admit(const ip_addr_t *source_ip);
+#endif
 void snmp_receive(void *handle, struct pbuf *p, const ip_addr_t *source_ip, u16_t port);
 err_t snmp_sendto(void *handle, struct pbuf *p, const ip_addr_t *dst, u16_t port);
+/* snmp_get_local_ip_for_dst() results besides 1 (found) and 0 (routing error) */
+/** No local IP address of the destination's IP version, destination is skipped */
+#define SNMP_LOCAL_IP_NO_VERSION 2
 u8_t snmp_get_local_ip_for_dst(void *handle, const ip_addr_t *dst, ip_addr_t *result);
+u16_t snmp_get_max_payload_for_dst(void *handle, const ip_addr_t *dst);
 err_t snmp_varbind_length(struct snmp_varbind *varbind, struct snmp_varbind_len *len);
 err_t snmp_append_outbound_varbind(struct snmp_pbuf_stream *pbuf_stream, struct snmp_varbind *varbind);
 
@@ -110,6 +110,36 @@ snmp_get_local_ip_for_dst(void *handle, const ip_addr_t *dst, ip_addr_t *result)
   }
 }
 
+u16_t
+snmp_get_max_payload_for_dst(void *handle, const ip_addr_t *dst)
+{
+  struct netconn *conn = (struct netconn *)handle;
+  struct netif *dst_if;
+  const ip_addr_t *dst_ip;
+
+  LWIP_UNUSED_ARG(conn); /* unused in case of IPV4 only configuration */
+
+  ip_route_get_local_ip(&conn->pcb.udp->local_ip, dst, dst_if, dst_ip);
+  LWIP_UNUSED_ARG(dst_ip);
+
+  if ((dst_if == NULL) || (dst_if->mtu == 0)) {
+    /* no limit known */
+    return 0;
+  }
+
+  /* with IP fragmentation the link MTU does not limit the response */
+#if LWIP_IPV6
+  if (IP_IS_V6(dst)) {
+    return LWIP_IPV6_FRAG ? 0 : (u16_t)(netif_mtu6(dst_if) - IP6_HLEN - UDP_HLEN);
+  }
+#endif /* LWIP_IPV6 */
+#if LWIP_IPV4
+  return IP_FRAG ? 0 : (u16_t)(dst_if->mtu - IP_HLEN - UDP_HLEN);
+#else
+  return 0;
+#endif /* LWIP_IPV4 */
+}
+
 /**
  * Starts SNMP Agent.
  */
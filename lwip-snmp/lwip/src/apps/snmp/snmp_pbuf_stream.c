@@ -118,7 +118,7 @@ snmp_pbuf_stream_writeto(struct snmp_pbuf_stream *pbuf_stream, struct snmp_pbuf_
       return ERR_BUF;
     }
 
-    chunk_len = LWIP_MIN(len, pbuf->len);
+    chunk_len = LWIP_MIN(len, pbuf->len - target_offset);
     err = snmp_pbuf_stream_writebuf(target_pbuf_stream, &((u8_t *)pbuf->payload)[target_offset], chunk_len);
     if (err != ERR_OK) {
       return err;
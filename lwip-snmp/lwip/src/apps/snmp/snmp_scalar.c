@@ -109,6 +109,9 @@ snmp_scalar_array_get_instance(const u32_t *root_oid, u8_t root_oid_len, struct
       instance->set_test            = snmp_scalar_array_set_test;
       instance->set_value           = snmp_scalar_array_set_value;
       instance->reference.const_ptr = array_node_def;
+#if SNMP_VALUE_CACHE_SIZE > 0
+      instance->cache_ttl           = array_node_def->cache_ttl;
+#endif
 
       return SNMP_ERR_NOERROR;
     }
@@ -186,6 +189,9 @@ snmp_scalar_array_get_next_instance(const u32_t *root_oid, u8_t root_oid_len, st
   instance->set_test            = snmp_scalar_array_set_test;
   instance->set_value           = snmp_scalar_array_set_value;
   instance->reference.const_ptr = result;
+#if SNMP_VALUE_CACHE_SIZE > 0
+  instance->cache_ttl           = result->cache_ttl;
+#endif
 
   return SNMP_ERR_NOERROR;
 }
@@ -79,7 +79,24 @@ static const struct snmp_obj_id *snmp_priv_algo_to_oid(snmpv3_priv_algo_t algo)
   return &usmNoPrivProtocol;
 }
 
-char username[32];
+/* rows keep the index of their user in the instance reference, so concurrent requests share no name buffer */
+static u8_t
+usmusertable_find_user(const char *name, u8_t *index)
+{
+  char username[SNMP_V3_MAX_USER_LENGTH + 1];
+  u8_t i;
+
+  for (i = 0; i < snmpv3_get_amount_of_users(); i++) {
+    memset(username, 0, sizeof(username));
+    snmpv3_get_username(username, i);
+    if (strcmp(username, name) == 0) {
+      *index = i;
+      return 1;
+    }
+  }
+
+  return 0;
+}
 
 static snmp_err_t usmusertable_get_instance(const u32_t *column, const u32_t *row_oid, u8_t row_oid_len, struct snmp_node_instance *cell_instance)
 {
@@ -94,6 +111,9 @@ static snmp_err_t usmusertable_get_instance(const u32_t *column, const u32_t *ro
   u8_t name_start;
   u8_t engineid_start;
 
+  char username[SNMP_V3_MAX_USER_LENGTH + 1];
+  u8_t user_index;
+
   LWIP_UNUSED_ARG(column);
 
   snmpv3_get_engine_id(&engineid, &eid_len);
@@ -144,12 +164,12 @@ static snmp_err_t usmusertable_get_instance(const u32_t *column, const u32_t *ro
   /* Verify if user exists */
   memset(username, 0, sizeof(username));
   snmp_oid_to_name(username, &row_oid[name_start], name_len);
-  if (snmpv3_get_user(username, NULL, NULL, NULL, NULL) != ERR_OK) {
+  if ((snmpv3_get_user(username, NULL, NULL, NULL, NULL) != ERR_OK) || !usmusertable_find_user(username, &user_index)) {
     return SNMP_ERR_NOSUCHINSTANCE;
   }
 
-  /* Save name in reference pointer to make it easier to handle later on */
-  cell_instance->reference.ptr = username;
+  /* Save user index in reference to make it easier to handle later on */
+  cell_instance->reference.u32 = user_index;
   cell_instance->reference_len = name_len;
 
   /* user was found */
@@ -185,6 +205,8 @@ static snmp_err_t usmusertable_get_next_instance(const u32_t *column, struct snm
 
   u32_t result_temp[LWIP_ARRAYSIZE(usmUserTable_oid_ranges)];
 
+  char username[SNMP_V3_MAX_USER_LENGTH + 1];
+
   LWIP_UNUSED_ARG(column);
 
   snmpv3_get_engine_id(&engineid, &eid_len);
@@ -252,6 +274,7 @@ static snmp_err_t usmusertable_get_next_instance(const u32_t *column, struct snm
     test_oid[0] = eid_len;
     snmp_engineid_to_oid(engineid, &test_oid[1], eid_len);
 
+    memset(username, 0, sizeof(username));
     snmpv3_get_username(username, i);
 
     test_oid[1 + eid_len] = strlen(username);
@@ -264,10 +287,10 @@ static snmp_err_t usmusertable_get_next_instance(const u32_t *column, struct snm
   /* did we find a next one? */
   if (state.status == SNMP_NEXT_OID_STATUS_SUCCESS) {
     snmp_oid_assign(row_oid, state.next_oid, state.next_oid_len);
-    /* store username for subsequent operations (get/test/set) */
+    /* store user index for subsequent operations (get/test/set) */
     memset(username, 0, sizeof(username));
     snmpv3_get_username(username, LWIP_PTR_NUMERIC_CAST(u8_t, state.reference));
-    cell_instance->reference.ptr = username;
+    cell_instance->reference.u32 = LWIP_PTR_NUMERIC_CAST(u8_t, state.reference);
     cell_instance->reference_len = strlen(username);
     return SNMP_ERR_NOERROR;
   }
@@ -279,10 +302,14 @@ static snmp_err_t usmusertable_get_next_instance(const u32_t *column, struct snm
 static s16_t usmusertable_get_value(struct snmp_node_instance *cell_instance, void *value)
 {
   snmpv3_user_storagetype_t storage_type;
+  char username[SNMP_V3_MAX_USER_LENGTH + 1];
+
+  memset(username, 0, sizeof(username));
+  snmpv3_get_username(username, (u8_t)cell_instance->reference.u32);
 
   switch (SNMP_TABLE_GET_COLUMN_FROM_OID(cell_instance->instance_oid.id)) {
     case 3: /* usmUserSecurityName */
-      MEMCPY(value, cell_instance->reference.ptr, cell_instance->reference_len);
+      MEMCPY(value, username, cell_instance->reference_len);
       return (s16_t)cell_instance->reference_len;
     case 4: /* usmUserCloneFrom */
       MEMCPY(value, snmp_zero_dot_zero.id, snmp_zero_dot_zero.len * sizeof(u32_t));
@@ -290,7 +317,7 @@ static s16_t usmusertable_get_value(struct snmp_node_instance *cell_instance, vo
     case 5: { /* usmUserAuthProtocol */
       const struct snmp_obj_id *auth_algo;
       snmpv3_auth_algo_t auth_algo_val;
-      snmpv3_get_user((const char *)cell_instance->reference.ptr, &auth_algo_val, NULL, NULL, NULL);
+      snmpv3_get_user(username, &auth_algo_val, NULL, NULL, NULL);
       auth_algo = snmp_auth_algo_to_oid(auth_algo_val);
       MEMCPY(value, auth_algo->id, auth_algo->len * sizeof(u32_t));
       return auth_algo->len * sizeof(u32_t);
@@ -302,7 +329,7 @@ static s16_t usmusertable_get_value(struct snmp_node_instance *cell_instance, vo
     case 8: { /* usmUserPrivProtocol */
       const struct snmp_obj_id *priv_algo;
       snmpv3_priv_algo_t priv_algo_val;
-      snmpv3_get_user((const char *)cell_instance->reference.ptr, NULL, NULL, &priv_algo_val, NULL);
+      snmpv3_get_user(username, NULL, NULL, &priv_algo_val, NULL);
       priv_algo = snmp_priv_algo_to_oid(priv_algo_val);
       MEMCPY(value, priv_algo->id, priv_algo->len * sizeof(u32_t));
       return priv_algo->len * sizeof(u32_t);
@@ -315,7 +342,7 @@ static s16_t usmusertable_get_value(struct snmp_node_instance *cell_instance, vo
       /* TODO: Implement usmUserPublic */
       return 0;
     case 12: /* usmUserStorageType */
-      snmpv3_get_user_storagetype((const char *)cell_instance->reference.ptr, &storage_type);
+      snmpv3_get_user_storagetype(username, &storage_type);
       *(s32_t *)value = storage_type;
       return sizeof(s32_t);
     case 13: /* usmUserStatus */
@@ -333,22 +360,22 @@ static s16_t usmstats_scalars_get_value(const struct snmp_scalar_array_node_def
   u32_t *uint_ptr = (u32_t *)value;
   switch (node->oid) {
     case 1: /* usmStatsUnsupportedSecLevels */
-      *uint_ptr = snmp_stats.unsupportedseclevels;
+      *uint_ptr = SNMP_STATS_GET(unsupportedseclevels);
       break;
     case 2: /* usmStatsNotInTimeWindows */
-      *uint_ptr = snmp_stats.notintimewindows;
+      *uint_ptr = SNMP_STATS_GET(notintimewindows);
       break;
     case 3: /* usmStatsUnknownUserNames */
-      *uint_ptr = snmp_stats.unknownusernames;
+      *uint_ptr = SNMP_STATS_GET(unknownusernames);
       break;
     case 4: /* usmStatsUnknownEngineIDs */
-      *uint_ptr = snmp_stats.unknownengineids;
+      *uint_ptr = SNMP_STATS_GET(unknownengineids);
       break;
     case 5: /* usmStatsWrongDigests */
-      *uint_ptr = snmp_stats.wrongdigests;
+      *uint_ptr = SNMP_STATS_GET(wrongdigests);
       break;
     case 6: /* usmStatsDecryptionErrors */
-      *uint_ptr = snmp_stats.decryptionerrors;
+      *uint_ptr = SNMP_STATS_GET(decryptionerrors);
       break;
     default:
       LWIP_DEBUGF(SNMP_MIB_DEBUG, ("usmstats_scalars_get_value(): unknown id: %"S32_F"\n", node->oid));
@@ -363,17 +390,17 @@ static s16_t usmstats_scalars_get_value(const struct snmp_scalar_array_node_def
 /* --- usmUser 1.3.6.1.6.3.15.1.2 ----------------------------------------------------- */
 
 static const struct snmp_table_col_def usmusertable_columns[] = {
-  {3,  SNMP_ASN1_TYPE_OCTET_STRING, SNMP_NODE_INSTANCE_READ_ONLY}, /* usmUserSecurityName */
-  {4,  SNMP_ASN1_TYPE_OBJECT_ID,    SNMP_NODE_INSTANCE_READ_ONLY}, /* usmUserCloneFrom */
-  {5,  SNMP_ASN1_TYPE_OBJECT_ID,    SNMP_NODE_INSTANCE_READ_ONLY}, /* usmUserAuthProtocol */
-  {6,  SNMP_ASN1_TYPE_OCTET_STRING, SNMP_NODE_INSTANCE_READ_ONLY}, /* usmUserAuthKeyChange */
-  {7,  SNMP_ASN1_TYPE_OCTET_STRING, SNMP_NODE_INSTANCE_READ_ONLY}, /* usmUserOwnAuthKeyChange */
-  {8,  SNMP_ASN1_TYPE_OBJECT_ID,    SNMP_NODE_INSTANCE_READ_ONLY}, /* usmUserPrivProtocol */
-  {9,  SNMP_ASN1_TYPE_OCTET_STRING, SNMP_NODE_INSTANCE_READ_ONLY}, /* usmUserPrivKeyChange */
-  {10, SNMP_ASN1_TYPE_OCTET_STRING, SNMP_NODE_INSTANCE_READ_ONLY}, /* usmUserOwnPrivKeyChange */
-  {11, SNMP_ASN1_TYPE_OCTET_STRING, SNMP_NODE_INSTANCE_READ_ONLY}, /* usmUserPublic */
-  {12, SNMP_ASN1_TYPE_INTEGER,      SNMP_NODE_INSTANCE_READ_ONLY}, /* usmUserStorageType */
-  {13, SNMP_ASN1_TYPE_INTEGER,      SNMP_NODE_INSTANCE_READ_ONLY}, /* usmUserStatus */
+  {3,  SNMP_ASN1_TYPE_OCTET_STRING, SNMP_NODE_INSTANCE_READ_ONLY SNMP_NODE_CACHE_TTL(0)}, /* usmUserSecurityName */
+  {4,  SNMP_ASN1_TYPE_OBJECT_ID,    SNMP_NODE_INSTANCE_READ_ONLY SNMP_NODE_CACHE_TTL(0)}, /* usmUserCloneFrom */
+  {5,  SNMP_ASN1_TYPE_OBJECT_ID,    SNMP_NODE_INSTANCE_READ_ONLY SNMP_NODE_CACHE_TTL(0)}, /* usmUserAuthProtocol */
+  {6,  SNMP_ASN1_TYPE_OCTET_STRING, SNMP_NODE_INSTANCE_READ_ONLY SNMP_NODE_CACHE_TTL(0)}, /* usmUserAuthKeyChange */
+  {7,  SNMP_ASN1_TYPE_OCTET_STRING, SNMP_NODE_INSTANCE_READ_ONLY SNMP_NODE_CACHE_TTL(0)}, /* usmUserOwnAuthKeyChange */
+  {8,  SNMP_ASN1_TYPE_OBJECT_ID,    SNMP_NODE_INSTANCE_READ_ONLY SNMP_NODE_CACHE_TTL(0)}, /* usmUserPrivProtocol */
+  {9,  SNMP_ASN1_TYPE_OCTET_STRING, SNMP_NODE_INSTANCE_READ_ONLY SNMP_NODE_CACHE_TTL(0)}, /* usmUserPrivKeyChange */
+  {10, SNMP_ASN1_TYPE_OCTET_STRING, SNMP_NODE_INSTANCE_READ_ONLY SNMP_NODE_CACHE_TTL(0)}, /* usmUserOwnPrivKeyChange */
+  {11, SNMP_ASN1_TYPE_OCTET_STRING, SNMP_NODE_INSTANCE_READ_ONLY SNMP_NODE_CACHE_TTL(0)}, /* usmUserPublic */
+  {12, SNMP_ASN1_TYPE_INTEGER,      SNMP_NODE_INSTANCE_READ_ONLY SNMP_NODE_CACHE_TTL(0)}, /* usmUserStorageType */
+  {13, SNMP_ASN1_TYPE_INTEGER,      SNMP_NODE_INSTANCE_READ_ONLY SNMP_NODE_CACHE_TTL(0)}, /* usmUserStatus */
 };
 static const struct snmp_table_node usmusertable = SNMP_TABLE_CREATE(2, usmusertable_columns, usmusertable_get_instance, usmusertable_get_next_instance, usmusertable_get_value, NULL, NULL);
 
@@ -384,12 +411,12 @@ static const struct snmp_tree_node usmuser_treenode = SNMP_CREATE_TREE_NODE(2, u
 
 /* --- usmMIBObjects 1.3.6.1.6.3.15.1 ----------------------------------------------------- */
 static const struct snmp_scalar_array_node_def usmstats_scalars_nodes[] = {
-  {1, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY}, /* usmStatsUnsupportedSecLevels */
-  {2, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY}, /* usmStatsNotInTimeWindows */
-  {3, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY}, /* usmStatsUnknownUserNames */
-  {4, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY}, /* usmStatsUnknownEngineIDs */
-  {5, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY}, /* usmStatsWrongDigests */
-  {6, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY}, /* usmStatsDecryptionErrors */
+  {1, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY SNMP_NODE_CACHE_TTL(0)}, /* usmStatsUnsupportedSecLevels */
+  {2, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY SNMP_NODE_CACHE_TTL(0)}, /* usmStatsNotInTimeWindows */
+  {3, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY SNMP_NODE_CACHE_TTL(0)}, /* usmStatsUnknownUserNames */
+  {4, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY SNMP_NODE_CACHE_TTL(0)}, /* usmStatsUnknownEngineIDs */
+  {5, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY SNMP_NODE_CACHE_TTL(0)}, /* usmStatsWrongDigests */
+  {6, SNMP_ASN1_TYPE_COUNTER, SNMP_NODE_INSTANCE_READ_ONLY SNMP_NODE_CACHE_TTL(0)}, /* usmStatsDecryptionErrors */
 };
 static const struct snmp_scalar_array_node usmstats_scalars = SNMP_SCALAR_CREATE_ARRAY_NODE(1, usmstats_scalars_nodes, usmstats_scalars_get_value, NULL, NULL);
 
@@ -41,6 +41,7 @@
 
 #include "lwip/apps/snmp_core.h"
 #include "lwip/apps/snmp_table.h"
+#include "lwip/sys.h"
 #include <string.h>
 
 snmp_err_t snmp_table_get_instance(const u32_t *root_oid, u8_t root_oid_len, struct snmp_node_instance *instance)
@@ -70,6 +71,9 @@ snmp_err_t snmp_table_get_instance(const u32_t *root_oid, u8_t root_oid_len, str
       /* everything may be overwritten by get_cell_instance_method() in order to implement special handling for single columns/cells */
       instance->asn1_type = col_def->asn1_type;
       instance->access    = col_def->access;
+#if SNMP_VALUE_CACHE_SIZE > 0
+      instance->cache_ttl = col_def->cache_ttl;
+#endif
       instance->get_value = table_node->get_value;
       instance->set_test  = table_node->set_test;
       instance->set_value = table_node->set_value;
@@ -136,6 +140,9 @@ snmp_err_t snmp_table_get_next_instance(const u32_t *root_oid, u8_t root_oid_len
 
     instance->asn1_type          = next_col_def->asn1_type;
     instance->access             = next_col_def->access;
+#if SNMP_VALUE_CACHE_SIZE > 0
+    instance->cache_ttl          = next_col_def->cache_ttl;
+#endif
 
     result = table_node->get_next_cell_instance(
                &next_col_def->index,
@@ -195,6 +202,9 @@ snmp_err_t snmp_table_simple_get_instance(const u32_t *root_oid, u8_t root_oid_l
       if (i > 0) {
         instance->asn1_type = col_def->asn1_type;
         instance->access    = SNMP_NODE_INSTANCE_READ_ONLY;
+#if SNMP_VALUE_CACHE_SIZE > 0
+        instance->cache_ttl = col_def->cache_ttl;
+#endif
         instance->set_test  = NULL;
         instance->set_value = NULL;
 
@@ -224,6 +234,106 @@ snmp_err_t snmp_table_simple_get_instance(const u32_t *root_oid, u8_t root_oid_l
   return ret;
 }
 
+#if SNMP_TABLE_NEXT_CELLS > 0
+/**
+ * Prepares cells for collecting the rows following start_oid, called by get_next_cells() before it scans its rows.
+ */
+void
+snmp_next_cells_init(struct snmp_next_cells *cells, const u32_t *start_oid, u8_t start_oid_len)
+{
+  cells->fetched          = sys_now();
+  cells->start_oid        = start_oid;
+  cells->start_oid_len    = start_oid_len;
+  cells->count            = 0;
+  cells->pos              = 0;
+  cells->row_oid_overflow = 0;
+}
+
+/**
+ * Checks the passed row OID if it is one of the SNMP_TABLE_NEXT_CELLS rows closest behind the start OID (get_next_cells);
+ * returns !=0 if the row was taken into cells, otherwise 0
+ */
+u8_t
+snmp_next_cells_check(struct snmp_next_cells *cells, const u32_t *oid, u8_t oid_len, void *reference)
+{
+  u8_t i, j;
+
+  /* check passed OID is located behind start offset */
+  if (snmp_oid_compare(oid, oid_len, cells->start_oid, cells->start_oid_len) <= 0) {
+    return 0;
+  }
+
+  /* find position, cells are kept ascending */
+  i = cells->count;
+  while ((i > 0) && (snmp_oid_compare(oid, oid_len, cells->row_oid[i - 1], cells->row_oid_len[i - 1]) < 0)) {
+    i--;
+  }
+  if ((i >= SNMP_TABLE_NEXT_CELLS) ||
+      ((i > 0) && (snmp_oid_compare(oid, oid_len, cells->row_oid[i - 1], cells->row_oid_len[i - 1]) == 0))) {
+    /* behind all cells of a full set, or already taken */
+    return 0;
+  }
+  if (oid_len > SNMP_TABLE_NEXT_CELLS_ROW_OID_LEN) {
+    cells->row_oid_overflow = 1;
+    return 0;
+  }
+
+  /* move the following cells up, the last one drops out if all cells are in use */
+  j = (cells->count < SNMP_TABLE_NEXT_CELLS) ? cells->count : (SNMP_TABLE_NEXT_CELLS - 1);
+  for (; j > i; j--) {
+    MEMCPY(cells->row_oid[j], cells->row_oid[j - 1], cells->row_oid_len[j - 1] * sizeof(u32_t));
+    cells->row_oid_len[j] = cells->row_oid_len[j - 1];
+    cells->value[j]       = cells->value[j - 1];
+    cells->value_len[j]   = cells->value_len[j - 1];
+  }
+
+  MEMCPY(cells->row_oid[i], oid, oid_len * sizeof(u32_t));
+  cells->row_oid_len[i] = oid_len;
+  cells->value[i].ptr   = reference;
+  cells->value_len[i]   = 0;
+  if (cells->count < SNMP_TABLE_NEXT_CELLS) {
+    cells->count++;
+  }
+
+  return 1;
+}
+
+static snmp_err_t
+snmp_table_simple_get_next_cell(const struct snmp_table_simple_node *table_node, const struct snmp_table_simple_col_def *col_def, struct snmp_obj_id *row_oid, struct snmp_node_instance *instance)
+{
+  struct snmp_next_cells *cells = instance->next_cells;
+
+  /* pointer values may be gone until the next repetition, only fetch plain values ahead */
+  if ((cells != NULL) && (table_node->get_next_cells != NULL) &&
+      ((col_def->data_type == SNMP_VARIANT_VALUE_TYPE_U32) || (col_def->data_type == SNMP_VARIANT_VALUE_TYPE_S32))) {
+    /* go on with the fetched cells if the row is the one handed out last, otherwise (or if they are used up) fetch again */
+    if ((cells->node != &table_node->node.node) || (cells->column != col_def->index) || (cells->pos == 0) ||
+        (snmp_oid_compare(row_oid->id, row_oid->len, cells->row_oid[cells->pos - 1], cells->row_oid_len[cells->pos - 1]) != 0) ||
+        ((cells->pos == cells->count) && (cells->count == SNMP_TABLE_NEXT_CELLS))) {
+      cells->node = NULL;
+      if ((table_node->get_next_cells(&col_def->index, row_oid, cells) != SNMP_ERR_NOERROR) || cells->row_oid_overflow) {
+        return table_node->get_next_cell_instance_and_value(&col_def->index, row_oid, &instance->reference, &instance->reference_len);
+      }
+      cells->node   = &table_node->node.node;
+      cells->column = col_def->index;
+    }
+
+    if (cells->pos < cells->count) {
+      snmp_oid_assign(row_oid, cells->row_oid[cells->pos], cells->row_oid_len[cells->pos]);
+      instance->reference     = cells->value[cells->pos];
+      instance->reference_len = cells->value_len[cells->pos];
+      cells->pos++;
+      return SNMP_ERR_NOERROR;
+    }
+
+    /* no further row in this column */
+    return SNMP_ERR_NOSUCHINSTANCE;
+  }
+
+  return table_node->get_next_cell_instance_and_value(&col_def->index, row_oid, &instance->reference, &instance->reference_len);
+}
+#endif /* SNMP_TABLE_NEXT_CELLS > 0 */
+
 snmp_err_t snmp_table_simple_get_next_instance(const u32_t *root_oid, u8_t root_oid_len, struct snmp_node_instance *instance)
 {
   const struct snmp_table_simple_node *table_node = (const struct snmp_table_simple_node *)(const void *)instance->node;
@@ -270,11 +380,15 @@ snmp_err_t snmp_table_simple_get_next_instance(const u32_t *root_oid, u8_t root_
       return SNMP_ERR_NOSUCHINSTANCE;
     }
 
+#if SNMP_TABLE_NEXT_CELLS > 0
+    result = snmp_table_simple_get_next_cell(table_node, next_col_def, &row_oid, instance);
+#else
     result = table_node->get_next_cell_instance_and_value(
                &next_col_def->index,
                &row_oid,
                &instance->reference,
                &instance->reference_len);
+#endif
 
     if (result == SNMP_ERR_NOERROR) {
       col_def = next_col_def;
@@ -287,6 +401,9 @@ snmp_err_t snmp_table_simple_get_next_instance(const u32_t *root_oid, u8_t root_
 
   instance->asn1_type = col_def->asn1_type;
   instance->access    = SNMP_NODE_INSTANCE_READ_ONLY;
+#if SNMP_VALUE_CACHE_SIZE > 0
+  instance->cache_ttl = col_def->cache_ttl;
+#endif
   instance->set_test  = NULL;
   instance->set_value = NULL;
 
@@ -39,15 +39,25 @@
 #include "lwip/apps/snmp_threadsync.h"
 #include "lwip/apps/snmp_core.h"
 #include "lwip/sys.h"
+#include "snmp_core_priv.h"
 #include <string.h>
 
+/* calls fn in the MIB thread, the time until it finished is added to instance (see SNMP_PROFILE) */
 static void
-call_synced_function(struct threadsync_data *call_data, snmp_threadsync_called_fn fn)
+call_synced_function(struct threadsync_data *call_data, snmp_threadsync_called_fn fn, struct snmp_node_instance *instance)
 {
+  SNMP_PROFILE_DECL(start)
+
+  SNMP_PROFILE_BEGIN(start);
   sys_mutex_lock(&call_data->threadsync_node->instance->sem_usage_mutex);
   call_data->threadsync_node->instance->sync_fn(fn, call_data);
   sys_sem_wait(&call_data->threadsync_node->instance->sem);
   sys_mutex_unlock(&call_data->threadsync_node->instance->sem_usage_mutex);
+#if SNMP_PROFILE
+  instance->sync_ticks += SNMP_PROFILE_ELAPSED(start);
+#else
+  LWIP_UNUSED_ARG(instance);
+#endif
 }
 
 static void
@@ -70,7 +80,7 @@ threadsync_get_value(struct snmp_node_instance *instance, void *value)
   struct threadsync_data *call_data = (struct threadsync_data *)instance->reference.ptr;
 
   call_data->arg1.value = value;
-  call_synced_function(call_data, threadsync_get_value_synced);
+  call_synced_function(call_data, threadsync_get_value_synced, instance);
 
   return call_data->retval.s16;
 }
@@ -96,7 +106,7 @@ threadsync_set_test(struct snmp_node_instance *instance, u16_t len, void *value)
 
   call_data->arg1.value = value;
   call_data->arg2.len = len;
-  call_synced_function(call_data, threadsync_set_test_synced);
+  call_synced_function(call_data, threadsync_set_test_synced, instance);
 
   return call_data->retval.err;
 }
@@ -122,11 +132,41 @@ threadsync_set_value(struct snmp_node_instance *instance, u16_t len, void *value
 
   call_data->arg1.value = value;
   call_data->arg2.len = len;
-  call_synced_function(call_data, threadsync_set_value_synced);
+  call_synced_function(call_data, threadsync_set_value_synced, instance);
 
   return call_data->retval.err;
 }
 
+static struct threadsync_data *
+threadsync_data_alloc(struct snmp_threadsync_instance *instance)
+{
+  struct threadsync_data *call_data = NULL;
+  u8_t i;
+  SYS_ARCH_DECL_PROTECT(old_level);
+
+  SYS_ARCH_PROTECT(old_level);
+  for (i = 0; i < LWIP_ARRAYSIZE(instance->data); i++) {
+    if (!instance->data[i].in_use) {
+      call_data = &instance->data[i];
+      call_data->in_use = 1;
+      break;
+    }
+  }
+  SYS_ARCH_UNPROTECT(old_level);
+
+  return call_data;
+}
+
+static void
+threadsync_data_free(struct threadsync_data *call_data)
+{
+  SYS_ARCH_DECL_PROTECT(old_level);
+
+  SYS_ARCH_PROTECT(old_level);
+  call_data->in_use = 0;
+  SYS_ARCH_UNPROTECT(old_level);
+}
+
 static void
 threadsync_release_instance_synced(void *ctx)
 {
@@ -143,8 +183,10 @@ threadsync_release_instance(struct snmp_node_instance *instance)
   struct threadsync_data *call_data = (struct threadsync_data *)instance->reference.ptr;
 
   if (call_data->proxy_instance.release_instance != NULL) {
-    call_synced_function(call_data, threadsync_release_instance_synced);
+    call_synced_function(call_data, threadsync_release_instance_synced, instance);
   }
+
+  threadsync_data_free(call_data);
 }
 
 static void
@@ -173,36 +215,53 @@ static snmp_err_t
 do_sync(const u32_t *root_oid, u8_t root_oid_len, struct snmp_node_instance *instance, snmp_threadsync_called_fn fn)
 {
   const struct snmp_threadsync_node *threadsync_node = (const struct snmp_threadsync_node *)(const void *)instance->node;
-  struct threadsync_data *call_data = &threadsync_node->instance->data;
+  struct threadsync_data *call_data;
+  snmp_err_t err;
 
   if (threadsync_node->node.node.oid != threadsync_node->target->node.oid) {
     LWIP_DEBUGF(SNMP_DEBUG, ("Sync node OID does not match target node OID"));
     return SNMP_ERR_NOSUCHINSTANCE;
   }
 
+  call_data = threadsync_data_alloc(threadsync_node->instance);
+  if (call_data == NULL) {
+    LWIP_DEBUGF(SNMP_DEBUG, ("No free thread sync slot, more workers than SNMP_WORKER_THREADS?"));
+    return SNMP_ERR_GENERROR;
+  }
+
   memset(&call_data->proxy_instance, 0, sizeof(call_data->proxy_instance));
 
   instance->reference.ptr = call_data;
   snmp_oid_assign(&call_data->proxy_instance.instance_oid, instance->instance_oid.id, instance->instance_oid.len);
 
   call_data->proxy_instance.node = &threadsync_node->target->node;
+#if SNMP_TABLE_NEXT_CELLS > 0
+  call_data->proxy_instance.next_cells = instance->next_cells;
+#endif
   call_data->threadsync_node     = threadsync_node;
 
   call_data->arg1.root_oid       = root_oid;
   call_data->arg2.root_oid_len   = root_oid_len;
-  call_synced_function(call_data, fn);
+  call_synced_function(call_data, fn, instance);
 
   if (call_data->retval.err == SNMP_ERR_NOERROR) {
     instance->access           = call_data->proxy_instance.access;
     instance->asn1_type        = call_data->proxy_instance.asn1_type;
+#if SNMP_VALUE_CACHE_SIZE > 0
+    instance->cache_ttl        = call_data->proxy_instance.cache_ttl;
+#endif
     instance->release_instance = threadsync_release_instance;
     instance->get_value        = (call_data->proxy_instance.get_value != NULL) ? threadsync_get_value : NULL;
     instance->set_value        = (call_data->proxy_instance.set_value != NULL) ? threadsync_set_value : NULL;
     instance->set_test         = (call_data->proxy_instance.set_test != NULL) ?  threadsync_set_test  : NULL;
     snmp_oid_assign(&instance->instance_oid, call_data->proxy_instance.instance_oid.id, call_data->proxy_instance.instance_oid.len);
+    /* slot is freed in threadsync_release_instance() */
+    return SNMP_ERR_NOERROR;
   }
 
-  return call_data->retval.err;
+  err = call_data->retval.err;
+  threadsync_data_free(call_data);
+  return err;
 }
 
 snmp_err_t
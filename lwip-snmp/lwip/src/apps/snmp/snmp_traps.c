@@ -76,10 +76,10 @@ struct snmp_msg_trap {
   u16_t vbseqlen;
 };
 
-static u16_t snmp_trap_varbind_sum(struct snmp_msg_trap *trap, struct snmp_varbind *varbinds);
+static u16_t snmp_trap_varbind_sum(struct snmp_msg_trap *trap, struct snmp_varbind *varbinds, u16_t varbinds_enc_len);
 static u16_t snmp_trap_header_sum(struct snmp_msg_trap *trap, u16_t vb_len);
 static err_t snmp_trap_header_enc(struct snmp_msg_trap *trap, struct snmp_pbuf_stream *pbuf_stream);
-static err_t snmp_trap_varbind_enc(struct snmp_msg_trap *trap, struct snmp_pbuf_stream *pbuf_stream, struct snmp_varbind *varbinds);
+static err_t snmp_trap_varbind_enc(struct snmp_msg_trap *trap, struct snmp_pbuf_stream *pbuf_stream, struct snmp_varbind *varbinds, const u8_t *varbinds_enc);
 
 #define BUILD_EXEC(code) \
   if ((code) != ERR_OK) { \
@@ -102,6 +102,35 @@ static struct snmp_trap_dst trap_dst[SNMP_TRAP_DESTINATIONS];
 
 static u8_t snmp_auth_traps_enabled = 0;
 
+#if SNMP_TRAP_QUEUE_SIZE > 0
+#if !SNMP_USE_NETCONN
+#error SNMP_TRAP_QUEUE_SIZE needs SNMP_USE_NETCONN (for the trap sender thread)
+#endif
+#if !LWIP_SUPPORT_CUSTOM_PBUF
+#error SNMP_TRAP_QUEUE_SIZE needs LWIP_SUPPORT_CUSTOM_PBUF (for encoding varbinds into the queue)
+#endif
+
+struct snmp_trap_queue_entry {
+  const struct snmp_obj_id *eoid;
+  s32_t generic_trap;
+  s32_t specific_trap;
+  /* sysUpTime when queued */
+  u32_t ts;
+  /* varbinds copied into the queue, already encoded */
+  u16_t varbinds_len;
+  u8_t varbinds[SNMP_TRAP_QUEUE_VARBINDS_SIZE];
+};
+
+/* ring buffer, one slot is kept empty to tell full from empty */
+static struct snmp_trap_queue_entry trap_queue[SNMP_TRAP_QUEUE_SIZE + 1];
+static u16_t trap_queue_head;
+static u16_t trap_queue_tail;
+static sys_sem_t trap_queue_sem;
+#endif /* SNMP_TRAP_QUEUE_SIZE > 0 */
+
+static err_t snmp_send_trap_ts(const struct snmp_obj_id *eoid, s32_t generic_trap, s32_t specific_trap,
+                               struct snmp_varbind *varbinds, const u8_t *varbinds_enc, u16_t varbinds_enc_len, u32_t ts);
+
 /**
  * @ingroup snmp_traps
  * Sets enable switch for this trap destination.
@@ -111,9 +140,14 @@ static u8_t snmp_auth_traps_enabled = 0;
 void
 snmp_trap_dst_enable(u8_t dst_idx, u8_t enable)
 {
+  SYS_ARCH_DECL_PROTECT(old_level);
+
   LWIP_ASSERT_CORE_LOCKED();
   if (dst_idx < SNMP_TRAP_DESTINATIONS) {
+    /* guarded for the trap sender thread, see snmp_send_trap_ts() */
+    SYS_ARCH_PROTECT(old_level);
     trap_dst[dst_idx].enable = enable;
+    SYS_ARCH_UNPROTECT(old_level);
   }
 }
 
@@ -126,9 +160,13 @@ snmp_trap_dst_enable(u8_t dst_idx, u8_t enable)
 void
 snmp_trap_dst_ip_set(u8_t dst_idx, const ip_addr_t *dst)
 {
+  SYS_ARCH_DECL_PROTECT(old_level);
+
   LWIP_ASSERT_CORE_LOCKED();
   if (dst_idx < SNMP_TRAP_DESTINATIONS) {
+    SYS_ARCH_PROTECT(old_level);
     ip_addr_set(&trap_dst[dst_idx].dip, dst);
+    SYS_ARCH_UNPROTECT(old_level);
   }
 }
 
@@ -171,21 +209,45 @@ snmp_get_auth_traps_enabled(void)
  */
 err_t
 snmp_send_trap(const struct snmp_obj_id *eoid, s32_t generic_trap, s32_t specific_trap, struct snmp_varbind *varbinds)
+{
+  u32_t ts;
+
+  LWIP_ASSERT_CORE_LOCKED();
+
+  MIB2_COPY_SYSUPTIME_TO(&ts);
+  return snmp_send_trap_ts(eoid, generic_trap, specific_trap, varbinds, NULL, 0, ts);
+}
+
+/* send to all destinations, varbinds either as list or (varbinds_enc != NULL) already encoded */
+static err_t
+snmp_send_trap_ts(const struct snmp_obj_id *eoid, s32_t generic_trap, s32_t specific_trap,
+                  struct snmp_varbind *varbinds, const u8_t *varbinds_enc, u16_t varbinds_enc_len, u32_t ts)
 {
   struct snmp_msg_trap trap_msg;
+  struct snmp_trap_dst dst[SNMP_TRAP_DESTINATIONS];
   struct snmp_trap_dst *td;
   struct pbuf *p;
   u16_t i, tot_len;
+  u8_t local_ip;
   err_t err = ERR_OK;
-
-  LWIP_ASSERT_CORE_LOCKED();
+  SYS_ARCH_DECL_PROTECT(old_level);
 
   trap_msg.snmp_version = 0;
 
-  for (i = 0, td = &trap_dst[0]; i < SNMP_TRAP_DESTINATIONS; i++, td++) {
+  /* the trap sender thread runs without core lock, work on a consistent copy of the destinations */
+  SYS_ARCH_PROTECT(old_level);
+  MEMCPY(dst, trap_dst, sizeof(dst));
+  SYS_ARCH_UNPROTECT(old_level);
+
+  for (i = 0, td = &dst[0]; i < SNMP_TRAP_DESTINATIONS; i++, td++) {
     if ((td->enable != 0) && !ip_addr_isany(&td->dip)) {
       /* lookup current source address for this dst */
-      if (snmp_get_local_ip_for_dst(snmp_traps_handle, &td->dip, &trap_msg.sip)) {
+      local_ip = snmp_get_local_ip_for_dst(snmp_traps_handle, &td->dip, &trap_msg.sip);
+      if (local_ip == SNMP_LOCAL_IP_NO_VERSION) {
+        /* not an error, e.g. IPv6 destinations while the agent only has an IPv4 address */
+        LWIP_DEBUGF(SNMP_DEBUG, ("snmp_send_trap: no local IP address of destination %"U16_F" IP version, skipped\n", i));
+        SNMP_STATS_INC(outtrapskips);
+      } else if (local_ip) {
         if (eoid == NULL) {
           trap_msg.enterprise = snmp_get_device_enterprise_oid();
         } else {
@@ -199,10 +261,10 @@ snmp_send_trap(const struct snmp_obj_id *eoid, s32_t generic_trap, s32_t specifi
           trap_msg.spc_trap = 0;
         }
 
-        MIB2_COPY_SYSUPTIME_TO(&trap_msg.ts);
+        trap_msg.ts = ts;
 
         /* pass 0, calculate length fields */
-        tot_len = snmp_trap_varbind_sum(&trap_msg, varbinds);
+        tot_len = snmp_trap_varbind_sum(&trap_msg, varbinds, varbinds_enc_len);
         tot_len = snmp_trap_header_sum(&trap_msg, tot_len);
 
         /* allocate pbuf(s) */
@@ -213,10 +275,10 @@ snmp_send_trap(const struct snmp_obj_id *eoid, s32_t generic_trap, s32_t specifi
 
           /* pass 1, encode packet into the pbuf(s) */
           snmp_trap_header_enc(&trap_msg, &pbuf_stream);
-          snmp_trap_varbind_enc(&trap_msg, &pbuf_stream, varbinds);
+          snmp_trap_varbind_enc(&trap_msg, &pbuf_stream, varbinds, varbinds_enc);
 
-          snmp_stats.outtraps++;
-          snmp_stats.outpkts++;
+          SNMP_STATS_INC(outtraps);
+          SNMP_STATS_INC(outpkts);
 
           /** send to the TRAP destination */
           snmp_sendto(snmp_traps_handle, p, &td->dip, LWIP_IANA_PORT_SNMP_TRAP);
@@ -233,6 +295,120 @@ snmp_send_trap(const struct snmp_obj_id *eoid, s32_t generic_trap, s32_t specifi
   return err;
 }
 
+#if SNMP_TRAP_QUEUE_SIZE > 0
+/**
+ * @ingroup snmp_traps
+ * Queues a generic or enterprise specific trap message for sending by the trap sender thread.
+ * Never blocks and may be called from any thread or interrupt handler: the queue is only
+ * guarded by SYS_ARCH_PROTECT and the sender is woken by sys_sem_signal().
+ *
+ * @param eoid points to enterprise object identifier, NULL for device enterprise OID
+ * @param generic_trap is the trap code
+ * @param specific_trap used for enterprise traps when generic_trap == 6
+ * @param varbinds linked list of varbinds to be sent
+ * @return ERR_OK when queued, ERR_MEM if the queue is full (counted in snmp_stats.outtrapqueueoverflows),
+ * ERR_BUF if the encoded varbinds exceed SNMP_TRAP_QUEUE_VARBINDS_SIZE
+ *
+ * @note varbinds are copied into the queue and may be freed on return. eoid is not copied
+ * and must remain valid until the trap has been sent, e.g. static data.
+ */
+err_t
+snmp_send_trap_async(const struct snmp_obj_id *eoid, s32_t generic_trap, s32_t specific_trap, struct snmp_varbind *varbinds)
+{
+  struct snmp_trap_queue_entry *entry;
+  struct pbuf_custom pc;
+  struct pbuf *p;
+  struct snmp_pbuf_stream pbuf_stream;
+  u8_t varbinds_enc[SNMP_TRAP_QUEUE_VARBINDS_SIZE];
+  u16_t next;
+  err_t err = ERR_OK;
+  SYS_ARCH_DECL_PROTECT(old_level);
+
+  /* encode into a caller-provided pbuf, no allocation so this stays usable from interrupts */
+  p = pbuf_alloced_custom(PBUF_RAW, sizeof(varbinds_enc), PBUF_REF, &pc, varbinds_enc, sizeof(varbinds_enc));
+  snmp_pbuf_stream_init(&pbuf_stream, p, 0, sizeof(varbinds_enc));
+  while (varbinds != NULL) {
+    if (snmp_append_outbound_varbind(&pbuf_stream, varbinds) != ERR_OK) {
+      LWIP_DEBUGF(SNMP_DEBUG, ("snmp_send_trap_async(): varbinds exceed SNMP_TRAP_QUEUE_VARBINDS_SIZE\n"));
+      return ERR_BUF;
+    }
+    varbinds = varbinds->next;
+  }
+
+  SYS_ARCH_PROTECT(old_level);
+  next = (u16_t)((trap_queue_head + 1) % LWIP_ARRAYSIZE(trap_queue));
+  if (next == trap_queue_tail) {
+    SNMP_STATS_SHARED.outtrapqueueoverflows++;
+    err = ERR_MEM;
+  } else {
+    entry = &trap_queue[trap_queue_head];
+    entry->eoid          = eoid;
+    entry->generic_trap  = generic_trap;
+    entry->specific_trap = specific_trap;
+    MIB2_COPY_SYSUPTIME_TO(&entry->ts);
+    entry->varbinds_len  = pbuf_stream.offset;
+    MEMCPY(entry->varbinds, varbinds_enc, pbuf_stream.offset);
+    trap_queue_head = next;
+  }
+  SYS_ARCH_UNPROTECT(old_level);
+
+  if ((err == ERR_OK) && sys_sem_valid(&trap_queue_sem)) {
+    sys_sem_signal(&trap_queue_sem);
+  }
+
+  return err;
+}
+
+static u8_t
+snmp_trap_queue_get(struct snmp_trap_queue_entry *entry)
+{
+  u8_t ret = 0;
+  SYS_ARCH_DECL_PROTECT(old_level);
+
+  SYS_ARCH_PROTECT(old_level);
+  if (trap_queue_tail != trap_queue_head) {
+    *entry = trap_queue[trap_queue_tail];
+    trap_queue_tail = (u16_t)((trap_queue_tail + 1) % LWIP_ARRAYSIZE(trap_queue));
+    ret = 1;
+  }
+  SYS_ARCH_UNPROTECT(old_level);
+
+  return ret;
+}
+
+static void
+snmp_trap_queue_thread(void *arg)
+{
+  struct snmp_trap_queue_entry entry;
+
+  LWIP_UNUSED_ARG(arg);
+
+  while (1) {
+    sys_arch_sem_wait(&trap_queue_sem, 0);
+
+    /* send all traps pending by now in one go */
+    while (snmp_trap_queue_get(&entry)) {
+      if (snmp_send_trap_ts(entry.eoid, entry.generic_trap, entry.specific_trap,
+                            NULL, entry.varbinds, entry.varbinds_len, entry.ts) != ERR_OK) {
+        SNMP_STATS_INC(outtrapqueuedrops);
+      }
+    }
+  }
+}
+
+/**
+ * Starts the trap sender thread. Called once by the transport from snmp_init().
+ */
+void
+snmp_trap_queue_init(void)
+{
+  err_t err = sys_sem_new(&trap_queue_sem, 0);
+  LWIP_UNUSED_ARG(err); /* in case of LWIP_NOASSERT */
+  LWIP_ASSERT("Failed to set up semaphore", err == ERR_OK);
+  sys_thread_new("snmp_trap", snmp_trap_queue_thread, NULL, SNMP_STACK_SIZE, SNMP_THREAD_PRIO);
+}
+#endif /* SNMP_TRAP_QUEUE_SIZE > 0 */
+
 /**
  * @ingroup snmp_traps
  * Send generic SNMP trap
@@ -272,18 +448,24 @@ void
 snmp_authfail_trap(void)
 {
   if (snmp_auth_traps_enabled != 0) {
+#if SNMP_TRAP_QUEUE_SIZE > 0
+    /* don't hold up the request thread on sending */
+    static const struct snmp_obj_id oid = { 7, { 1, 3, 6, 1, 2, 1, 11 } };
+    snmp_send_trap_async(&oid, SNMP_GENTRAP_AUTH_FAILURE, 0, NULL);
+#else
     snmp_send_trap_generic(SNMP_GENTRAP_AUTH_FAILURE);
+#endif
   }
 }
 
 static u16_t
-snmp_trap_varbind_sum(struct snmp_msg_trap *trap, struct snmp_varbind *varbinds)
+snmp_trap_varbind_sum(struct snmp_msg_trap *trap, struct snmp_varbind *varbinds, u16_t varbinds_enc_len)
 {
   struct snmp_varbind *varbind;
   u16_t tot_len;
   u8_t tot_len_len;
 
-  tot_len = 0;
+  tot_len = varbinds_enc_len;
   varbind = varbinds;
   while (varbind != NULL) {
     struct snmp_varbind_len len;
@@ -367,7 +549,7 @@ snmp_trap_header_sum(struct snmp_msg_trap *trap, u16_t vb_len)
 }
 
 static err_t
-snmp_trap_varbind_enc(struct snmp_msg_trap *trap, struct snmp_pbuf_stream *pbuf_stream, struct snmp_varbind *varbinds)
+snmp_trap_varbind_enc(struct snmp_msg_trap *trap, struct snmp_pbuf_stream *pbuf_stream, struct snmp_varbind *varbinds, const u8_t *varbinds_enc)
 {
   struct snmp_asn1_tlv tlv;
   struct snmp_varbind *varbind;
@@ -377,6 +559,10 @@ snmp_trap_varbind_enc(struct snmp_msg_trap *trap, struct snmp_pbuf_stream *pbuf_
   SNMP_ASN1_SET_TLV_PARAMS(tlv, SNMP_ASN1_TYPE_SEQUENCE, 0, trap->vbseqlen);
   BUILD_EXEC( snmp_ans1_enc_tlv(pbuf_stream, &tlv) );
 
+  if (varbinds_enc != NULL) {
+    BUILD_EXEC( snmp_asn1_enc_raw(pbuf_stream, varbinds_enc, trap->vbseqlen) );
+  }
+
   while (varbind != NULL) {
     BUILD_EXEC( snmp_append_outbound_varbind(pbuf_stream, varbind) );
 
@@ -98,7 +98,8 @@ snmpv3_get_engine_time_internal(void)
  *
  * Implementing RFC3826 priv param algorithm if LWIP_RAND is available.
  *
- * @todo: This is a potential thread safety issue.
+ * The counter is read and incremented atomically, so concurrent workers
+ * (SNMP_WORKER_THREADS > 1) never use the same IV.
  */
 err_t
 snmpv3_build_priv_param(u8_t *priv_param)
@@ -106,28 +107,48 @@ snmpv3_build_priv_param(u8_t *priv_param)
 #ifdef LWIP_RAND /* Based on RFC3826 */
   static u8_t init;
   static u32_t priv1, priv2;
+  u32_t rand1 = 0, rand2 = 0;
+  u32_t param1, param2;
+  SYS_ARCH_DECL_PROTECT(old_level);
 
+  if (init == 0) {
+    /* draw outside of the protected region, only the first caller uses them */
+    rand1 = LWIP_RAND();
+    rand2 = LWIP_RAND();
+  }
+
+  SYS_ARCH_PROTECT(old_level);
   /* Lazy initialisation */
   if (init == 0) {
     init = 1;
-    priv1 = LWIP_RAND();
-    priv2 = LWIP_RAND();
+    priv1 = rand1;
+    priv2 = rand2;
   }
 
-  SMEMCPY(&priv_param[0], &priv1, sizeof(priv1));
-  SMEMCPY(&priv_param[4], &priv2, sizeof(priv2));
+  param1 = priv1;
+  param2 = priv2;
 
   /* Emulate 64bit increment */
   priv1++;
   if (!priv1) { /* Overflow */
     priv2++;
   }
+  SYS_ARCH_UNPROTECT(old_level);
+
+  SMEMCPY(&priv_param[0], &param1, sizeof(param1));
+  SMEMCPY(&priv_param[4], &param2, sizeof(param2));
 #else /* Based on RFC3414 */
   static u32_t ctr;
   u32_t boots = snmpv3_get_engine_boots_internal();
+  u32_t param;
+  SYS_ARCH_DECL_PROTECT(old_level);
+
+  SYS_ARCH_PROTECT(old_level);
+  param = ctr++;
+  SYS_ARCH_UNPROTECT(old_level);
+
   SMEMCPY(&priv_param[0], &boots, 4);
-  SMEMCPY(&priv_param[4], &ctr, 4);
-  ctr++;
+  SMEMCPY(&priv_param[4], &param, 4);
 #endif
   return ERR_OK;
 }
@@ -75,6 +75,10 @@ struct snmp_varbind
  */
 void snmp_init(void);
 void snmp_set_mibs(const struct snmp_mib **mibs, u8_t num_mibs);
+#if SNMP_MIB_REGISTRY_SIZE > 0
+err_t snmp_register_mib(const struct snmp_mib *mib);
+err_t snmp_unregister_mib(const struct snmp_mib *mib);
+#endif
 
 void snmp_set_device_enterprise_oid(const struct snmp_obj_id* device_enterprise_oid);
 const struct snmp_obj_id* snmp_get_device_enterprise_oid(void);
@@ -100,6 +104,9 @@ void snmp_trap_dst_ip_set(u8_t dst_idx, const ip_addr_t *dst);
 err_t snmp_send_trap_generic(s32_t generic_trap);
 err_t snmp_send_trap_specific(s32_t specific_trap, struct snmp_varbind *varbinds);
 err_t snmp_send_trap(const struct snmp_obj_id* oid, s32_t generic_trap, s32_t specific_trap, struct snmp_varbind *varbinds);
+#if SNMP_TRAP_QUEUE_SIZE > 0
+err_t snmp_send_trap_async(const struct snmp_obj_id* oid, s32_t generic_trap, s32_t specific_trap, struct snmp_varbind *varbinds);
+#endif
 
 #define SNMP_AUTH_TRAPS_DISABLED 0
 #define SNMP_AUTH_TRAPS_ENABLED  1
@@ -191,8 +191,19 @@ typedef snmp_err_t (*node_instance_set_test_method)(struct snmp_node_instance*,
 typedef snmp_err_t (*node_instance_set_value_method)(struct snmp_node_instance*, u16_t, void*);
 typedef void (*node_instance_release_method)(struct snmp_node_instance*);
 
+#if SNMP_TABLE_NEXT_CELLS > 0
+struct snmp_next_cells;
+#endif
+
 #define SNMP_GET_VALUE_RAW_DATA 0x4000  /* do not use 0x8000 because return value of node_instance_get_value_method is signed16 and 0x8000 would be the signed bit */
 
+#if SNMP_VALUE_CACHE_SIZE > 0
+/** appends a value cache TTL in milliseconds to the initializer of a node or column definition */
+#define SNMP_NODE_CACHE_TTL(ttl) , (ttl)
+#else
+#define SNMP_NODE_CACHE_TTL(ttl)
+#endif
+
 /** SNMP node instance */
 struct snmp_node_instance
 {
@@ -219,6 +230,18 @@ struct snmp_node_instance
   union snmp_variant_value reference;
   /** see reference (if reference is a pointer, the length of underlying data may be stored here or anything else) */
   u32_t reference_len;
+#if SNMP_TABLE_NEXT_CELLS > 0
+  /** cells fetched ahead for the GetBulk repeater this instance is resolved for (NULL if none), see snmp_table_simple_node */
+  struct snmp_next_cells *next_cells;
+#endif
+#if SNMP_VALUE_CACHE_SIZE > 0
+  /** time in milliseconds the value may be served from the value cache (0: not cached), see SNMP_VALUE_CACHE_SIZE */
+  u16_t cache_ttl;
+#endif
+#if SNMP_PROFILE
+  /** ticks spent waiting for thread sync while resolving and accessing this instance, see SNMP_PROFILE */
+  u32_t sync_ticks;
+#endif
 };
 
 
@@ -327,6 +350,39 @@ err_t snmp_decode_truthvalue(const s32_t *asn1_value, u8_t *bool_value);
 u8_t  snmp_encode_bits(u8_t *buf, u32_t buf_len, u32_t bit_value, u8_t bit_count);
 u8_t  snmp_encode_truthvalue(s32_t *asn1_value, u32_t bool_value);
 
+#if SNMP_PROFILE
+/** PDU types the phase histograms are kept for */
+enum snmp_profile_pdu {
+  SNMP_PROFILE_PDU_GET,
+  SNMP_PROFILE_PDU_GETNEXT,
+  SNMP_PROFILE_PDU_GETBULK,
+  SNMP_PROFILE_PDU_SET,
+  /** requests which could not be parsed or were answered with a report */
+  SNMP_PROFILE_PDU_OTHER,
+  SNMP_PROFILE_PDUS
+};
+
+/** Request phases, parse includes v3 auth/decrypt and encode includes v3 encrypt/auth,
+ * resolve, get_value and set_value include thread sync waits */
+enum snmp_profile_phase {
+  SNMP_PROFILE_PARSE,
+  SNMP_PROFILE_RESOLVE,
+  SNMP_PROFILE_GET_VALUE,
+  SNMP_PROFILE_SET_VALUE,
+  SNMP_PROFILE_THREADSYNC,
+  SNMP_PROFILE_ENCODE,
+  SNMP_PROFILE_V3_SECURITY,
+  SNMP_PROFILE_SENDTO,
+  SNMP_PROFILE_PHASES
+};
+
+/** requests per PDU type whose phase took bucket ticks, see SNMP_PROFILE_BUCKETS.
+ * One histogram for all workers, not sharded like snmp_statistics */
+extern u32_t snmp_profile[SNMP_PROFILE_PDUS][SNMP_PROFILE_PHASES][SNMP_PROFILE_BUCKETS];
+
+u32_t snmp_profile_now(void);
+#endif
+
 struct snmp_statistics
 {
   u32_t inpkts;
@@ -356,6 +412,8 @@ struct snmp_statistics
   u32_t outsetrequests;
   u32_t outgetresponses;
   u32_t outtraps;
+  /* trap destinations skipped for lack of a local IP address of their IP version */
+  u32_t outtrapskips;
 #if LWIP_SNMP_V3
   u32_t unsupportedseclevels;
   u32_t notintimewindows;
@@ -364,9 +422,46 @@ struct snmp_statistics
   u32_t wrongdigests;
   u32_t decryptionerrors;
 #endif
+#if SNMP_OUTBOUND_PBUF_POOL_SIZE > 0
+  u32_t outpbufpoolhits;
+  u32_t outpbufpoolmisses;
+#endif
+#if SNMP_RESPONSE_CACHE_SIZE > 0
+  u32_t inresponsecachehits;
+#endif
+#if SNMP_TRAP_QUEUE_SIZE > 0
+  u32_t outtrapqueueoverflows;
+  u32_t outtrapqueuedrops;
+#endif
+#if SNMP_RECV_BATCH_SIZE > 1
+  u32_t inbatchsizes[SNMP_RECV_BATCH_SIZE];
+#endif
+#if SNMP_RATE_LIMIT_SOURCES > 0
+  u32_t inratelimitdrops;
+  u32_t inratelimitevictions;
+#endif
+#if SNMP_WALK_CACHE_SIZE > 0
+  u32_t walkcachehits;
+  u32_t walkcachemisses;
+#endif
+#if SNMP_VALUE_CACHE_SIZE > 0
+  u32_t valuecachehits;
+  u32_t valuecachemisses;
+#endif
 };
 
+#if SNMP_WORKER_THREADS > 1
+/* one shard per worker plus one shared shard for updates outside of a request, summed on read.
+ * There is no snmp_stats then, use SNMP_STATS_GET() (see SNMP_WORKER_THREADS) */
+extern struct snmp_statistics snmp_stats_shards[SNMP_WORKER_THREADS + 1];
+u32_t snmp_stats_sum(const u32_t *shard0_counter);
+/** Reads counter x of struct snmp_statistics */
+#define SNMP_STATS_GET(x) snmp_stats_sum(&snmp_stats_shards[0].x)
+#else
 extern struct snmp_statistics snmp_stats;
+/** Reads counter x of struct snmp_statistics */
+#define SNMP_STATS_GET(x) (snmp_stats.x)
+#endif
 
 #ifdef __cplusplus
 }
@@ -99,6 +99,30 @@
 #endif
 #endif /* SNMP_USE_NETCONN */
 
+/**
+ * SNMP_WORKER_THREADS: Number of threads which may call snmp_receive() concurrently.
+ * Values > 1 make the SNMP core safe for concurrent requests: statistics are kept in
+ * one shard per worker (read them with SNMP_STATS_GET()), SET requests are serialized,
+ * and every thread sync instance keeps one proxy slot per worker. The transport must call snmp_msg_init() before the first request.
+ * Every worker processes its request on its own stack, so each needs SNMP_STACK_SIZE.
+ * Note the global snmp_stats does not exist then: code reading snmp_stats.x directly fails to link
+ * and has to read SNMP_STATS_GET(x) instead, which works with any number of workers.
+ */
+#if !defined SNMP_WORKER_THREADS || defined __DOXYGEN__
+#define SNMP_WORKER_THREADS             1
+#endif
+
+/**
+ * SNMP_RECV_BATCH_SIZE: Maximum number of requests the transport receives per wakeup.
+ * After blocking for the first datagram, the transport keeps receiving without blocking
+ * until the socket is drained or this many datagrams are taken, then handles them all
+ * (value == 1 means one datagram per wakeup). snmp_stats.inbatchsizes[n - 1] counts
+ * wakeups which took n datagrams.
+ */
+#if !defined SNMP_RECV_BATCH_SIZE || defined __DOXYGEN__
+#define SNMP_RECV_BATCH_SIZE            1
+#endif
+
 /**
  * SNMP_TRAP_DESTINATIONS: Number of trap destinations. At least one trap
  * destination is required
@@ -107,6 +131,25 @@
 #define SNMP_TRAP_DESTINATIONS          1
 #endif
 
+/**
+ * SNMP_TRAP_QUEUE_SIZE: Number of traps which can be pending in the asynchronous trap queue
+ * (value == 0 means no queue, traps are only sent synchronously by snmp_send_trap()).
+ * Traps queued by snmp_send_trap_async() are sent by a dedicated thread, which also takes
+ * authentication failure traps off the request path. Needs SNMP_USE_NETCONN for the thread.
+ */
+#if !defined SNMP_TRAP_QUEUE_SIZE || defined __DOXYGEN__
+#define SNMP_TRAP_QUEUE_SIZE            0
+#endif
+
+/**
+ * SNMP_TRAP_QUEUE_VARBINDS_SIZE: Bytes reserved per queued trap for its varbinds.
+ * snmp_send_trap_async() copies the varbinds into the queue in encoded form and fails
+ * with ERR_BUF if they do not fit.
+ */
+#if !defined SNMP_TRAP_QUEUE_VARBINDS_SIZE || defined __DOXYGEN__
+#define SNMP_TRAP_QUEUE_VARBINDS_SIZE   128
+#endif
+
 /**
  * Only allow SNMP write actions that are 'safe' (e.g. disabling netifs is not
  * a safe action and disabled when SNMP_SAFE_REQUESTS = 1).
@@ -263,6 +306,245 @@
 #define SNMP_LWIP_GETBULK_MAX_REPETITIONS 0
 #endif
 
+/**
+ * SNMP_GETBULK_CURSORS: Number of repeaters a GetBulk request can track in a cursor
+ * (value == 0 means no cursors).
+ * With cursors, every repetition after the first continues from the OID each repeater returned
+ * last, instead of decoding the varbinds just written into the response again. A repeater that
+ * reached endOfMibView is not resolved again. Requests with more repeaters than cursors fall back
+ * to decoding the response. One set of cursors is kept per worker thread (SNMP_WORKER_THREADS),
+ * each cursor holding one OID of SNMP_MAX_OBJ_ID_LEN.
+ */
+#if !defined SNMP_GETBULK_CURSORS || defined __DOXYGEN__
+#define SNMP_GETBULK_CURSORS 0
+#endif
+
+/**
+ * SNMP_TABLE_NEXT_CELLS: Number of successor cells a GetBulk repeater fetches from one scan of a
+ * simple table providing get_next_cells (value == 0 means every repetition scans the table again).
+ * The cells are kept with the repeater cursor, so this requires SNMP_GETBULK_CURSORS > 0.
+ * Only columns with U32/S32 values are fetched ahead, pointer values are read per repetition.
+ */
+#if !defined SNMP_TABLE_NEXT_CELLS || defined __DOXYGEN__
+#define SNMP_TABLE_NEXT_CELLS 0
+#endif
+
+/**
+ * SNMP_TABLE_NEXT_CELLS_ROW_OID_LEN: Maximum row OID length of a cell fetched ahead.
+ * Tables with longer row OIDs are scanned once per repetition.
+ */
+#if !defined SNMP_TABLE_NEXT_CELLS_ROW_OID_LEN || defined __DOXYGEN__
+#define SNMP_TABLE_NEXT_CELLS_ROW_OID_LEN 16
+#endif
+
+/**
+ * SNMP_MAX_MSG_SIZE: Largest response message (UDP payload) the SNMP agent builds.
+ * This is also the msgMaxSize the agent advertises in SNMPv3 responses.
+ * A response is further limited to the msgMaxSize of an SNMPv3 request and to the largest UDP payload
+ * reaching the manager without fragmentation, unless the stack can fragment IP datagrams to it
+ * (see snmp_get_max_payload_for_dst()).
+ * Values above the link MTU therefore only take effect with IP fragmentation (e.g. IP_FRAG).
+ */
+#if !defined SNMP_MAX_MSG_SIZE || defined __DOXYGEN__
+#define SNMP_MAX_MSG_SIZE 1472
+#endif
+
+/**
+ * SNMP_OUTBOUND_PBUF_POOL_SIZE: Number of response buffers preallocated by the SNMP agent
+ * (value == 0 means no pool, every response is allocated from lwIP heap).
+ * A response normally takes one buffer of SNMP_MAX_MSG_SIZE out of this pool rather than
+ * pbuf_alloc() from lwIP heap, and returns it when the response pbuf is freed. If all buffers are in use,
+ * the response is dropped (see SNMP_OUTBOUND_PBUF_HEAP_FALLBACK). Pool usage is counted in snmp_stats
+ * (outpbufpoolhits/outpbufpoolmisses).
+ * Buffers are handed out as custom pbufs, so LWIP_SUPPORT_CUSTOM_PBUF must be enabled.
+ */
+#if !defined SNMP_OUTBOUND_PBUF_POOL_SIZE || defined __DOXYGEN__
+#define SNMP_OUTBOUND_PBUF_POOL_SIZE 0
+#endif
+
+/**
+ * SNMP_OUTBOUND_PBUF_HEAP_FALLBACK==1: Allocate the response from lwIP heap when
+ * all SNMP_OUTBOUND_PBUF_POOL_SIZE buffers are in use, instead of dropping it.
+ * Off by default, so the agent never takes more than the pool from RAM.
+ */
+#if !defined SNMP_OUTBOUND_PBUF_HEAP_FALLBACK || defined __DOXYGEN__
+#define SNMP_OUTBOUND_PBUF_HEAP_FALLBACK 0
+#endif
+
+/**
+ * SNMP_RESPONSE_CACHE_SIZE: Number of responses kept for answering retransmitted requests
+ * (value == 0 means no cache, every request is processed in full).
+ * A request matching a cached response by source IP, source port, version, PDU type, request ID and
+ * community (SNMPv3: msgID and user name) within SNMP_RESPONSE_CACHE_TIMEOUT is answered with the
+ * cached response instead of being processed again, so a retransmitted SET is never applied twice.
+ * The least recently used response is evicted when the cache is full. SNMPv3 reports are not cached.
+ */
+#if !defined SNMP_RESPONSE_CACHE_SIZE || defined __DOXYGEN__
+#define SNMP_RESPONSE_CACHE_SIZE 0
+#endif
+
+/**
+ * SNMP_RESPONSE_CACHE_TIMEOUT: Time in milliseconds a cached response is valid for retransmissions.
+ */
+#if !defined SNMP_RESPONSE_CACHE_TIMEOUT || defined __DOXYGEN__
+#define SNMP_RESPONSE_CACHE_TIMEOUT 2000
+#endif
+
+/**
+ * SNMP_RATE_LIMIT_SOURCES: Number of request sources tracked for admission control
+ * (value == 0 means no admission control, every request is processed).
+ * Each source IP gets a token bucket refilled at SNMP_RATE_LIMIT_RATE requests per second
+ * up to SNMP_RATE_LIMIT_BURST. The transport calls snmp_rate_limit_admit() before passing
+ * a request to snmp_receive() and drops it without parsing if the bucket is empty.
+ * The least recently seen source is evicted when the table is full.
+ * Drops are counted in snmp_stats (inratelimitdrops).
+ */
+#if !defined SNMP_RATE_LIMIT_SOURCES || defined __DOXYGEN__
+#define SNMP_RATE_LIMIT_SOURCES 0
+#endif
+
+/**
+ * SNMP_RATE_LIMIT_RATE: Sustained requests per second admitted from one source.
+ */
+#if !defined SNMP_RATE_LIMIT_RATE || defined __DOXYGEN__
+#define SNMP_RATE_LIMIT_RATE 20
+#endif
+
+/**
+ * SNMP_RATE_LIMIT_BURST: Requests admitted back-to-back from one idle source.
+ */
+#if !defined SNMP_RATE_LIMIT_BURST || defined __DOXYGEN__
+#define SNMP_RATE_LIMIT_BURST 40
+#endif
+
+/**
+ * SNMP_WALK_CACHE_SIZE: Number of managers whose GetNext walk position is kept
+ * (value == 0 means no cache, every GetNext is resolved from the MIB root).
+ * For each source IP and port the OID returned for the first varbind of the last GetNext is kept
+ * together with the MIB and node it came from, and with SNMP_TABLE_NEXT_CELLS the table cells
+ * fetched ahead. A GetNext starting at that OID continues there instead of resolving it again.
+ * Cells fetched ahead are fetched again once SNMP_WALK_CACHE_TIMEOUT has passed since their scan,
+ * however often the walk continues, so they are at most that old when a request starts using them.
+ * SET requests and snmp_set_mibs() invalidate the cache. The least recently used entry is replaced
+ * when the cache is full. Lookups are counted in snmp_stats (walkcachehits/walkcachemisses).
+ */
+#if !defined SNMP_WALK_CACHE_SIZE || defined __DOXYGEN__
+#define SNMP_WALK_CACHE_SIZE 0
+#endif
+
+/**
+ * SNMP_WALK_CACHE_TIMEOUT: Time in milliseconds a walk position is kept without being used,
+ * and after which the table cells fetched ahead for it are fetched again.
+ */
+#if !defined SNMP_WALK_CACHE_TIMEOUT || defined __DOXYGEN__
+#define SNMP_WALK_CACHE_TIMEOUT 2000
+#endif
+
+/**
+ * SNMP_VALUE_CACHE_SIZE: Number of object values kept for all managers
+ * (value == 0 means no cache, every read calls get_value()).
+ * Only objects whose node definition declares a TTL (cache_ttl member of snmp_scalar_array_node_def,
+ * snmp_table_col_def or snmp_table_simple_col_def, see SNMP_NODE_CACHE_TTL()) are cached, keyed by their
+ * full instance OID. A read within the TTL is answered from the cache without get_value(), and a Get
+ * without resolving the MIB tree either. Objects with a longer OID than SNMP_VALUE_CACHE_OID_LEN or a longer
+ * value than SNMP_VALUE_CACHE_VALUE_LEN are not cached. The least recently used entry is replaced when the
+ * cache is full. SET requests and snmp_set_mibs() empty the cache.
+ * Reads of cacheable objects are counted in snmp_stats (valuecachehits/valuecachemisses).
+ */
+#if !defined SNMP_VALUE_CACHE_SIZE || defined __DOXYGEN__
+#define SNMP_VALUE_CACHE_SIZE 0
+#endif
+
+/**
+ * SNMP_VALUE_CACHE_OID_LEN: Maximum instance OID length of a cached value.
+ */
+#if !defined SNMP_VALUE_CACHE_OID_LEN || defined __DOXYGEN__
+#define SNMP_VALUE_CACHE_OID_LEN 16
+#endif
+
+/**
+ * SNMP_VALUE_CACHE_VALUE_LEN: Maximum length of a cached value (8 covers all integer types).
+ */
+#if !defined SNMP_VALUE_CACHE_VALUE_LEN || defined __DOXYGEN__
+#define SNMP_VALUE_CACHE_VALUE_LEN 8
+#endif
+
+/**
+ * SNMP_LWIP_MIB2_CACHE_TTL: TTL in milliseconds of the interface counters of MIB2 in the value cache
+ * (value == 0 means they are not cached). Only used with SNMP_VALUE_CACHE_SIZE.
+ */
+#if !defined SNMP_LWIP_MIB2_CACHE_TTL || defined __DOXYGEN__
+#define SNMP_LWIP_MIB2_CACHE_TTL 0
+#endif
+
+/**
+ * SNMP_SET_VARBIND_INDEX_SIZE: Number of varbinds of a SET request whose position the
+ * test phase records, so the commit phase decodes their OID and value without parsing
+ * the varbind list again (value == 0 disables the index). SET requests with more
+ * varbinds are parsed twice. Every entry takes 10 bytes of the worker stack.
+ */
+#if !defined SNMP_SET_VARBIND_INDEX_SIZE || defined __DOXYGEN__
+#define SNMP_SET_VARBIND_INDEX_SIZE 0
+#endif
+
+/**
+ * SNMP_PROFILE==1: Time the phases of every request (parse, OID resolution, get_value,
+ * set_test/set_value, thread sync waits, encode, v3 auth/crypt, sendto) into log2
+ * histograms per PDU type, counted in snmp_profile. The port has to provide
+ * u32_t snmp_profile_now(void), a free running tick counter (e.g. a cycle counter).
+ */
+#if !defined SNMP_PROFILE || defined __DOXYGEN__
+#define SNMP_PROFILE 0
+#endif
+
+/**
+ * SNMP_PROFILE_BUCKETS: Number of buckets of a phase histogram. Bucket n counts phases
+ * which took [2^n, 2^(n+1)) ticks (bucket 0 from 0 ticks), the last bucket also all longer ones.
+ */
+#if !defined SNMP_PROFILE_BUCKETS || defined __DOXYGEN__
+#define SNMP_PROFILE_BUCKETS 24
+#endif
+
+/**
+ * SNMP_RESPONSE_HEADER_TEMPLATES==1: Keep the invariant header of v1/v2c responses (message
+ * sequence, version, community and PDU sequence) encoded per community and version, built by
+ * snmp_set_community() and snmp_set_community_write(). A response then starts with one copy of
+ * the template and one of request ID, error status, error index and varbind list header,
+ * instead of encoding them TLV by TLV. Communities left at their defaults are encoded per response.
+ */
+#if !defined SNMP_RESPONSE_HEADER_TEMPLATES || defined __DOXYGEN__
+#define SNMP_RESPONSE_HEADER_TEMPLATES 0
+#endif
+
+/**
+ * SNMP_SORTED_TREE_NODES==1: Resolve subnodes of tree nodes by binary search, O(log k) per level
+ * instead of scanning all k subnodes. snmp_set_mibs() checks that the subnodes of every tree node
+ * (SNMP_CREATE_TREE_NODE()) are in ascending OID order; if any are not, all MIBs are scanned as before.
+ * MIBs used without snmp_set_mibs() are scanned as well.
+ */
+#if !defined SNMP_SORTED_TREE_NODES || defined __DOXYGEN__
+#define SNMP_SORTED_TREE_NODES 0
+#endif
+
+/**
+ * SNMP_MIB_REGISTRY_SIZE: Maximum number of MIBs snmp_set_mibs() sorts by base OID, so the MIB of
+ * an OID (longest base OID prefix) and the MIB following an OID are found by binary search
+ * instead of comparing the OID with every MIB (value == 0 means always comparing with every MIB).
+ * More MIBs than this are compared one by one as well.
+ */
+#if !defined SNMP_MIB_REGISTRY_SIZE || defined __DOXYGEN__
+#define SNMP_MIB_REGISTRY_SIZE 0
+#endif
+
+/**
+ * SNMP_MEMORY_BARRIER: Full memory barrier ordering the registry changes of snmp_register_mib(),
+ * snmp_unregister_mib() and snmp_set_mibs() with the requests picking them up without a lock
+ * (SNMP_MIB_REGISTRY_SIZE > 0). Needed if workers run on more than one CPU core.
+ */
+#if !defined SNMP_MEMORY_BARRIER || defined __DOXYGEN__
+#define SNMP_MEMORY_BARRIER()
+#endif
+
 /**
  * @}
  */
@@ -77,6 +77,10 @@ struct snmp_scalar_array_node_def
   u32_t         oid;
   u8_t          asn1_type;
   snmp_access_t access;
+#if SNMP_VALUE_CACHE_SIZE > 0
+  /** value cache TTL in milliseconds (0: not cached), set with SNMP_NODE_CACHE_TTL() */
+  u16_t         cache_ttl;
+#endif
 };
 
 typedef s16_t (*snmp_scalar_array_get_value_method)(const struct snmp_scalar_array_node_def*, void*);
@@ -53,6 +53,10 @@ struct snmp_table_col_def
   u32_t index;
   u8_t asn1_type;
   snmp_access_t access;
+#if SNMP_VALUE_CACHE_SIZE > 0
+  /** value cache TTL in milliseconds (0: not cached), set with SNMP_NODE_CACHE_TTL() */
+  u16_t cache_ttl;
+#endif
 };
 
 /** table node */
@@ -99,8 +103,42 @@ struct snmp_table_simple_col_def
   u32_t index;
   u8_t asn1_type;
   snmp_table_column_data_type_t data_type; /* depending of what union member is used to store the value*/
+#if SNMP_VALUE_CACHE_SIZE > 0
+  /** value cache TTL in milliseconds (0: not cached), set with SNMP_NODE_CACHE_TTL() */
+  u16_t cache_ttl;
+#endif
+};
+
+#if SNMP_TABLE_NEXT_CELLS > 0
+/** cells of one column following a row, ascending by row OID */
+struct snmp_next_cells
+{
+  /** table and column the cells were fetched for, NULL if empty */
+  const struct snmp_node* node;
+  u32_t column;
+  /** sys_now() when the scan fetching the cells started */
+  u32_t fetched;
+  /** row OID the cells follow, only valid while fetching */
+  const u32_t* start_oid;
+  u8_t start_oid_len;
+  /** number of cells fetched and next cell to hand out */
+  u8_t count;
+  u8_t pos;
+  /** set while fetching if a row OID was longer than SNMP_TABLE_NEXT_CELLS_ROW_OID_LEN */
+  u8_t row_oid_overflow;
+  u8_t row_oid_len[SNMP_TABLE_NEXT_CELLS];
+  u32_t row_oid[SNMP_TABLE_NEXT_CELLS][SNMP_TABLE_NEXT_CELLS_ROW_OID_LEN];
+  /** cell values; while fetching, the reference passed to snmp_next_cells_check() */
+  union snmp_variant_value value[SNMP_TABLE_NEXT_CELLS];
+  u32_t value_len[SNMP_TABLE_NEXT_CELLS];
 };
 
+void snmp_next_cells_init(struct snmp_next_cells* cells, const u32_t* start_oid, u8_t start_oid_len);
+u8_t snmp_next_cells_check(struct snmp_next_cells* cells, const u32_t* oid, u8_t oid_len, void* reference);
+#else
+struct snmp_next_cells;
+#endif
+
 /** simple read-only table node */
 struct snmp_table_simple_node
 {
@@ -110,6 +148,10 @@ struct snmp_table_simple_node
   const struct snmp_table_simple_col_def* columns;
   snmp_err_t (*get_cell_value)(const u32_t* column, const u32_t* row_oid, u8_t row_oid_len, union snmp_variant_value* value, u32_t* value_len);
   snmp_err_t (*get_next_cell_instance_and_value)(const u32_t* column, struct snmp_obj_id* row_oid, union snmp_variant_value* value, u32_t* value_len);
+  /** optional: fills cells with the rows following row_oid and their values in column from one scan
+      (see snmp_next_cells_init()/snmp_next_cells_check()), used by GetBulk instead of one
+      get_next_cell_instance_and_value() call per repetition */
+  snmp_err_t (*get_next_cells)(const u32_t* column, const struct snmp_obj_id* row_oid, struct snmp_next_cells* cells);
 };
 
 snmp_err_t snmp_table_simple_get_instance(const u32_t *root_oid, u8_t root_oid_len, struct snmp_node_instance* instance);
@@ -119,7 +161,19 @@ snmp_err_t snmp_table_simple_get_next_instance(const u32_t *root_oid, u8_t root_
   {{{ SNMP_NODE_TABLE, (oid) }, \
   snmp_table_simple_get_instance, \
   snmp_table_simple_get_next_instance }, \
-  (u16_t)LWIP_ARRAYSIZE(columns), (columns), (get_cell_value_method), (get_next_cell_instance_and_value_method) }
+  (u16_t)LWIP_ARRAYSIZE(columns), (columns), (get_cell_value_method), (get_next_cell_instance_and_value_method), NULL }
+
+#if SNMP_TABLE_NEXT_CELLS > 0
+#define SNMP_TABLE_CREATE_SIMPLE_NEXT_CELLS(oid, columns, get_cell_value_method, get_next_cell_instance_and_value_method, get_next_cells_method) \
+  {{{ SNMP_NODE_TABLE, (oid) }, \
+  snmp_table_simple_get_instance, \
+  snmp_table_simple_get_next_instance }, \
+  (u16_t)LWIP_ARRAYSIZE(columns), (columns), (get_cell_value_method), (get_next_cell_instance_and_value_method), \
+  (get_next_cells_method) }
+#else
+#define SNMP_TABLE_CREATE_SIMPLE_NEXT_CELLS(oid, columns, get_cell_value_method, get_next_cell_instance_and_value_method, get_next_cells_method) \
+  SNMP_TABLE_CREATE_SIMPLE(oid, columns, get_cell_value_method, get_next_cell_instance_and_value_method)
+#endif
 
 s16_t snmp_table_extract_value_from_s32ref(struct snmp_node_instance* instance, void* value);
 s16_t snmp_table_extract_value_from_u32ref(struct snmp_node_instance* instance, void* value);
@@ -70,6 +70,7 @@ struct threadsync_data
   } arg2;
   const struct snmp_threadsync_node *threadsync_node;
   struct snmp_node_instance proxy_instance;
+  u8_t in_use;
 };
 
 /** Thread sync instance. Needed EXCATLY once for every thread to be synced into. */
@@ -78,7 +79,8 @@ struct snmp_threadsync_instance
   sys_sem_t                       sem;
   sys_mutex_t                     sem_usage_mutex;
   snmp_threadsync_synchronizer_fn sync_fn;
-  struct threadsync_data          data;
+  /* one proxy slot for every worker, held from get_instance to release_instance */
+  struct threadsync_data          data[SNMP_WORKER_THREADS];
 };
 
 /** SNMP thread sync proxy leaf node */